@@ -25,6 +25,7 @@
 
 #include <graphene/app/api.hpp>
 #include <graphene/app/api_access.hpp>
+#include <graphene/app/broadcast_confirmation_registry.hpp>
 
 #include "database_api_helper.hxx"
 
@@ -117,7 +118,7 @@ namespace graphene { namespace app {
     }
 
     // block_api
-    block_api::block_api(const graphene::chain::database& db) : _db(db) { /* Nothing to do */ }
+    block_api::block_api(application& app) : _app(app), _db(*app.chain_database()) { /* Nothing to do */ }
 
     vector<optional<signed_block>> block_api::get_blocks(uint32_t block_num_from, uint32_t block_num_to)const
     {
@@ -129,35 +130,111 @@ namespace graphene { namespace app {
        return res;
     }
 
-    network_broadcast_api::network_broadcast_api(application& a):_app(a)
+    static string encode_raw_block_data( const char* data, size_t size, block_api::block_encoding encoding )
     {
-       _applied_block_connection = _app.chain_database()->applied_block.connect(
-                                         [this](const signed_block& b){ on_applied_block(b); });
+       if( encoding == block_api::block_encoding::hex )
+          return fc::to_hex( data, size );
+       return fc::base64_encode( reinterpret_cast<const unsigned char*>( data ), size );
     }
 
-    void network_broadcast_api::on_applied_block( const signed_block& b )
+    block_api::block_range block_api::get_block_range( uint32_t start_block_num,
+                                                        const optional<uint32_t>& olimit,
+                                                        const optional<block_content>& ocontent,
+                                                        const optional<block_encoding>& oencoding )const
     {
-       if( _callbacks.size() )
+       const auto configured_limit = _app.get_options().api_limit_get_block_range;
+       uint32_t limit = olimit.valid() ? *olimit : configured_limit;
+       FC_ASSERT( limit <= configured_limit,
+                  "limit can not be greater than ${configured_limit}",
+                  ("configured_limit", configured_limit) );
+       FC_ASSERT( start_block_num > 0, "Block numbers start from 1" );
+
+       const block_content content = ocontent.valid() ? *ocontent : block_content::full;
+       const block_encoding encoding = oencoding.valid() ? *oencoding : block_encoding::object;
+
+       block_range result;
+       const uint32_t head_block_num = _db.head_block_num();
+       if( start_block_num > head_block_num || 0 == limit )
+          return result;
+
+       const uint32_t count = uint32_t( std::min<uint64_t>( limit, uint64_t(head_block_num) - start_block_num + 1 ) );
+       result.blocks.reserve( count );
+       for( uint32_t block_num = start_block_num; block_num < start_block_num + count; ++block_num )
        {
-          /// we need to ensure the database_api is not deleted for the life of the async operation
-          auto capture_this = shared_from_this();
-          for( uint32_t trx_num = 0; trx_num < b.transactions.size(); ++trx_num )
+          block_range_item item;
+          item.block_num = block_num;
+
+          if( content == block_content::transaction_ids
+                || ( content == block_content::full && encoding == block_encoding::object ) )
           {
-             const auto& trx = b.transactions[trx_num];
-             auto id = trx.id();
-             auto itr = _callbacks.find(id);
-             if( itr != _callbacks.end() )
+             // The whole block has to be unpacked anyway
+             optional<signed_block> block = _db.fetch_block_by_number( block_num );
+             if( !block.valid() )
+                continue;
+             item.block_id = block->id();
+             if( content == block_content::transaction_ids )
              {
-                auto block_num = b.block_num();
-                auto& callback = _callbacks.find(id)->second;
-                auto v = fc::variant( transaction_confirmation{ id, block_num, trx_num, trx },
-                                      GRAPHENE_MAX_NESTED_OBJECTS );
-                fc::async( [capture_this,v,callback]() {
-                   callback(v);
-                } );
+                item.transaction_ids = vector<transaction_id_type>();
+                item.transaction_ids->reserve( block->transactions.size() );
+                for( const auto& trx : block->transactions )
+                   item.transaction_ids->push_back( trx.id() );
              }
+             else
+                item.block = std::move( *block );
+          }
+          else
+          {
+             optional<vector<char>> packed = _db.fetch_raw_block_by_number( block_num );
+             if( !packed.valid() )
+                continue;
+
+             // The header is a prefix of the packed block, so it can be unpacked without touching the transactions
+             signed_block_header header;
+             fc::datastream<const char*> ds( packed->data(), packed->size() );
+             fc::raw::unpack( ds, header );
+             item.block_id = header.id();
+
+             if( content == block_content::full )
+                item.raw = encode_raw_block_data( packed->data(), packed->size(), encoding );
+             else if( encoding == block_encoding::object )
+                item.header = std::move( header );
+             else
+                item.raw = encode_raw_block_data( packed->data(), ds.tellp(), encoding );
           }
+
+          result.blocks.push_back( std::move( item ) );
        }
+
+       if( start_block_num + count <= head_block_num )
+          result.next_block_num = start_block_num + count;
+       return result;
+    }
+
+    network_broadcast_api::network_broadcast_api(application& a)
+    : _app(a), _session( a.get_broadcast_confirmations().new_session() )
+    {
+       // Nothing else to do
+    }
+
+    network_broadcast_api::~network_broadcast_api()
+    {
+       _app.get_broadcast_confirmations().remove_session( _session );
+    }
+
+    void network_broadcast_api::on_confirmation( const signed_block& b, uint32_t trx_num,
+                                                 const vector<operation_result>& results,
+                                                 const confirmation_callback& callback )
+    {
+       /// we need to ensure the database_api is not deleted for the life of the async operation
+       auto capture_this = shared_from_this();
+       // The transactions of applied blocks do not carry their operation results
+       processed_transaction trx = b.transactions[trx_num];
+       trx.operation_results = results;
+       auto v = fc::variant( transaction_confirmation{ trx.id(), b.block_num(), trx_num, trx },
+                             GRAPHENE_MAX_NESTED_OBJECTS );
+       fc::async( [capture_this,v,callback]() {
+          callback(v);
+       } );
     }
 
     void network_broadcast_api::broadcast_transaction(const precomputable_transaction& trx)
@@ -190,7 +267,13 @@ namespace graphene { namespace app {
     {
        FC_ASSERT( _app.p2p_node() != nullptr, "Not connected to P2P network, can't broadcast!" );
        _app.chain_database()->precompute_parallel( trx ).wait();
-       _callbacks[trx.id()] = cb;
+       std::weak_ptr<network_broadcast_api> weak_this = shared_from_this();
+       _app.get_broadcast_confirmations().add( _session, trx.id(), trx.expiration,
+             [weak_this,cb]( const signed_block& b, uint32_t trx_num, const vector<operation_result>& results ) {
+          auto self = weak_this.lock();
+          if( self )
+             self->on_confirmation( b, trx_num, results, cb );
+       });
        _app.chain_database()->push_transaction(trx);
        _app.p2p_node()->broadcast_transaction(trx);
     }
@@ -240,6 +323,34 @@ namespace graphene { namespace app {
        return _app.p2p_node()->set_advanced_node_parameters(params);
     }
 
+    chain::apply_profile network_node_api::get_apply_profile() const
+    {
+       const chain::apply_profiler* profiler = _app.chain_database()->get_apply_profiler();
+       FC_ASSERT( profiler != nullptr, "Apply profiler is not enabled" );
+       return profiler->get_profile();
+    }
+
+    void network_node_api::reset_apply_profile()
+    {
+       chain::apply_profiler* profiler = _app.chain_database()->get_apply_profiler();
+       FC_ASSERT( profiler != nullptr, "Apply profiler is not enabled" );
+       profiler->reset();
+    }
+
+    void network_node_api::dump_apply_profile() const
+    {
+       const chain::apply_profiler* profiler = _app.chain_database()->get_apply_profiler();
+       FC_ASSERT( profiler != nullptr, "Apply profiler is not enabled" );
+       const auto& file = _app.get_apply_profile_file();
+       FC_ASSERT( file.valid(), "No apply profile file is configured" );
+       profiler->save_profile( *file );
+    }
+
+    chain::fork_database_metrics network_node_api::get_fork_db_metrics() const
+    {
+       return _app.chain_database()->get_fork_db_metrics();
+    }
+
     fc::api<network_broadcast_api> login_api::network_broadcast()
     {
        bool is_allowed = ( _allowed_apis.find("network_broadcast_api") != _allowed_apis.end() );
@@ -257,7 +368,7 @@ namespace graphene { namespace app {
        FC_ASSERT( is_allowed, "Access denied" );
        if( !_block_api )
        {
-          _block_api = std::make_shared< block_api >( std::ref( *_app.chain_database() ) );
+          _block_api = std::make_shared< block_api >( std::ref( _app ) );
        }
        return *_block_api;
     }
@@ -439,24 +550,26 @@ namespace graphene { namespace app {
           }
        }
 
-       const auto& by_op_idx = db.get_index_type<account_history_index>().indices().get<by_op>();
-       auto itr = by_op_idx.lower_bound( boost::make_tuple( account, start ) );
-       auto itr_end = by_op_idx.lower_bound( boost::make_tuple( account, stop ) );
+       return db.run_read_only( [&db,&result,account,stop,limit,start]() {
+          const auto& by_op_idx = db.get_index_type<account_history_index>().indices().get<by_op>();
+          auto itr = by_op_idx.lower_bound( boost::make_tuple( account, start ) );
+          auto itr_end = by_op_idx.lower_bound( boost::make_tuple( account, stop ) );
 
-       while( itr != itr_end && result.size() < limit )
-       {
-          result.emplace_back( itr->operation_id(db) );
-          ++itr;
-       }
-       // Deal with a special case : include the object with ID 0 when it fits
-       if( 0 == stop.instance.value && result.size() < limit && itr != by_op_idx.end() )
-       {
-          const auto& obj = *itr;
-          if( obj.account == account )
-             result.emplace_back( obj.operation_id(db) );
-       }
+          while( itr != itr_end && result.size() < limit )
+          {
+             result.emplace_back( itr->operation_id(db) );
+             ++itr;
+          }
+          // Deal with a special case : include the object with ID 0 when it fits
+          if( 0 == stop.instance.value && result.size() < limit && itr != by_op_idx.end() )
+          {
+             const auto& obj = *itr;
+             if( obj.account == account )
+                result.emplace_back( obj.operation_id(db) );
+          }
 
-       return result;
+          return std::move( result );
+       });
     }
 
     vector<operation_history_object> history_api::get_account_history_by_time(
@@ -1013,6 +1126,31 @@ namespace graphene { namespace app {
       return result;
    }
 
+   vector< orders_api::limit_order_group_depth > orders_api::get_grouped_limit_order_depth(
+         const std::string& base_asset,
+         const std::string& quote_asset,
+         uint16_t group,
+         const optional<price>& start,
+         uint32_t limit )const
+   {
+      vector< limit_order_group > groups = get_grouped_limit_orders( base_asset, quote_asset, group, start, limit );
+      vector< limit_order_group_depth > result;
+      if( groups.empty() )
+         return result;
+
+      auto plugin = _app.get_plugin<graphene::grouped_orders::grouped_orders_plugin>( "grouped_orders" );
+      // Only one prefix sum query is needed, the rest is accumulated
+      share_type cumulative = plugin->cumulative_for_sale( group, groups.front().min_price )
+                            - groups.front().total_for_sale;
+      result.reserve( groups.size() );
+      for( const limit_order_group& g : groups )
+      {
+         cumulative += g.total_for_sale;
+         result.emplace_back( g, cumulative );
+      }
+      return result;
+   }
+
    // custom operations api
    custom_operations_api::custom_operations_api(application& app)
    : _app(app)
@@ -296,6 +296,13 @@ void application_impl::initialize(const fc::path& data_dir, shared_ptr<boost::pr
    if (_options->count("api-node-info") > 0)
       _node_info = _options->at("api-node-info").as<string>();
 
+   if( _options->count("apply-profile-file") > 0 )
+   {
+      _apply_profile_file = _options->at("apply-profile-file").as<boost::filesystem::path>();
+      if( _apply_profile_file->is_relative() )
+         _apply_profile_file = _data_dir / *_apply_profile_file;
+   }
+
    if( _options->count("api-access") > 0 )
    {
 
@@ -474,6 +481,10 @@ void application_impl::set_api_limit() {
       _app_options.api_limit_get_storage_info =
             _options->at("api-limit-get-storage-info").as<uint32_t>();
    }
+   if(_options->count("api-limit-get-block-range") > 0) {
+      _app_options.api_limit_get_block_range =
+            _options->at("api-limit-get-block-range").as<uint32_t>();
+   }
 }
 
 graphene::chain::genesis_state_type application_impl::initialize_genesis_state() const
@@ -554,6 +565,21 @@ void application_impl::open_chain_database() const
       _chain_db->enable_standby_votes_tracking( _options->at("enable-standby-votes-tracking").as<bool>() );
    }
 
+   if( _options->count("enable-apply-profiler") > 0 )
+   {
+      _chain_db->enable_apply_profiler( _options->at("enable-apply-profiler").as<bool>() );
+   }
+
+   if( _options->count("api-read-threads") > 0 )
+   {
+      _chain_db->set_read_only_threads( _options->at("api-read-threads").as<uint16_t>() );
+   }
+
+   if( _options->count("fork-db-max-memory") > 0 )
+   {
+      _chain_db->set_fork_db_max_memory( _options->at("fork-db-max-memory").as<uint64_t>() * 1024 * 1024 );
+   }
+
    if( _options->count("replay-blockchain") > 0 || _options->count("revalidate-blockchain") > 0 )
       _chain_db->wipe( _data_dir / "blockchain", false );
 
@@ -602,6 +628,13 @@ void application_impl::startup()
 
    open_chain_database();
 
+   // Maintain the known items after replaying, so that replaying is not slowed down
+   _known_items->set_head_block_num( _chain_db->head_block_num() );
+   _known_items_connection = _chain_db->applied_block.connect( [this]( const signed_block& b ) {
+      _known_items->add( net::item_id( graphene::net::block_message_type, b.id() ) );
+      _known_items->set_head_block_num( b.block_num() );
+   });
+
    startup_plugins();
 
    if( enable_p2p_network && _active_plugins.find( "delayed_node" ) == _active_plugins.end() )
@@ -693,6 +726,8 @@ bool application_impl::handle_block(const graphene::net::block_message& blk_msg,
          // leave that peer connected so that they can get sync blocks from us
          return _chain_db->push_block( blk_msg.block, skip );
       });
+      // the block might have been stored on a fork without being applied
+      _known_items->add( net::item_id( graphene::net::block_message_type, blk_msg.block_id ) );
 
       // the block was accepted, so we now know all of the transactions contained in the block
       if (!sync_mode)
@@ -704,10 +739,11 @@ bool application_impl::handle_block(const graphene::net::block_message& blk_msg,
          // during sync, it is unlikely that we'll see any old
          contained_transaction_msg_ids.reserve( contained_transaction_msg_ids.size()
                                                     + blk_msg.block.transactions.size() );
-         for (const processed_transaction& ptrx : blk_msg.block.transactions)
+         // the message ids were derived from the transactions while precomputing the block
+         for( const auto& derived : blk_msg.block.get_derived_data().transactions )
          {
-            graphene::net::trx_message transaction_message(ptrx);
-            contained_transaction_msg_ids.emplace_back(graphene::net::message(transaction_message).id());
+            contained_transaction_msg_ids.emplace_back( derived.message_id );
+            _known_items->add( net::item_id( graphene::net::trx_message_type, derived.message_id ) );
          }
       }
 
@@ -744,6 +780,7 @@ void application_impl::handle_transaction(const graphene::net::trx_message& tran
 
    _chain_db->precompute_parallel( transaction_message.trx ).wait();
    _chain_db->push_transaction( transaction_message.trx );
+   _known_items->add( net::item_id( graphene::net::trx_message_type, net::message( transaction_message ).id() ) );
 } FC_CAPTURE_AND_RETHROW( (transaction_message) ) } // GCOVR_EXCL_LINE
 
 void application_impl::handle_message(const message& message_to_process)
@@ -1075,6 +1112,11 @@ uint8_t application_impl::get_current_block_interval_in_seconds() const
    return _chain_db->get_global_properties().parameters.block_interval;
 }
 
+std::shared_ptr<const net::known_items_filter> application_impl::get_known_items_filter() const
+{
+   return _known_items;
+}
+
 void application_impl::shutdown()
 {
    ilog( "Shutting down application" );
@@ -1100,6 +1142,18 @@ void application_impl::shutdown()
 
    if( _chain_db )
    {
+      if( _apply_profile_file.valid() && _chain_db->get_apply_profiler() != nullptr )
+      {
+         ilog( "Writing apply profile to ${f}", ("f", *_apply_profile_file) );
+         try
+         {
+            _chain_db->get_apply_profiler()->save_profile( *_apply_profile_file );
+         }
+         catch( const fc::exception& e )
+         {
+            wlog( "Failed to write apply profile: ${e}", ("e", e.to_detail_string()) );
+         }
+      }
       ilog( "Closing chain database" );
       _chain_db->close();
       _chain_db.reset();
@@ -1226,6 +1280,18 @@ void application::set_program_options(boost::program_options::options_descriptio
          ("enable-standby-votes-tracking", bpo::value<bool>()->implicit_value(true),
           "Whether to enable tracking of votes of standby witnesses and committee members. "
           "Set it to true to provide accurate data to API clients, set to false for slightly better performance.")
+         ("enable-apply-profiler", bpo::value<bool>()->implicit_value(true),
+          "Whether to collect latency histograms of operations, evaluator phases and block processing steps, "
+          "which can be retrieved via the network_node_api::get_apply_profile API (default: false)")
+         ("apply-profile-file", bpo::value<boost::filesystem::path>(),
+          "File to write the collected apply profile to on shutdown or via the "
+          "network_node_api::dump_apply_profile API, relative to data-dir if not absolute")
+         ("api-read-threads", bpo::value<uint16_t>()->default_value(0),
+          "Number of worker threads for heavy read-only API calls such as database_api::get_full_accounts, "
+          "so that they run in parallel with each other and with networking. 0 to run them on the main thread")
+         ("fork-db-max-memory", bpo::value<uint64_t>()->default_value(0),
+          "Approximate limit in MiB for blocks kept in the fork database. When exceeded, blocks that are not on "
+          "the branch of the head block are dropped. 0 for no limit")
          ("api-limit-get-account-history-operations",
           bpo::value<uint32_t>()->default_value(default_opts.api_limit_get_account_history_operations),
           "For history_api::get_account_history_operations to set max limit value")
@@ -1337,6 +1403,9 @@ void application::set_program_options(boost::program_options::options_descriptio
          ("api-limit-get-storage-info",
           bpo::value<uint32_t>()->default_value(default_opts.api_limit_get_storage_info),
           "Set maximum limit value for APIs which query for account storage info")
+         ("api-limit-get-block-range",
+          bpo::value<uint32_t>()->default_value(default_opts.api_limit_get_block_range),
+          "Set maximum number of blocks to return for the block_api::get_block_range API")
          ;
    command_line_options.add(configuration_file_options);
    command_line_options.add_options()
@@ -1406,6 +1475,11 @@ std::shared_ptr<chain::database> application::chain_database() const
    return my->_chain_db;
 }
 
+broadcast_confirmation_registry& application::get_broadcast_confirmations()
+{
+   return my->_broadcast_confirmations;
+}
+
 void application::set_block_production(bool producing_blocks)
 {
    my->set_block_production(producing_blocks);
@@ -1446,6 +1520,11 @@ const string& application::get_node_info() const
    return my->_node_info;
 }
 
+const fc::optional<fc::path>& application::get_apply_profile_file() const
+{
+   return my->_apply_profile_file;
+}
+
 // namespace detail
 } }
 
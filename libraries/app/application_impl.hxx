@@ -5,6 +5,7 @@
 
 #include <graphene/app/application.hpp>
 #include <graphene/app/api_access.hpp>
+#include <graphene/app/broadcast_confirmation_registry.hpp>
 #include <graphene/chain/genesis_state.hpp>
 #include <graphene/protocol/types.hpp>
 #include <graphene/net/message.hpp>
@@ -30,7 +31,8 @@ class application_impl : public net::node_delegate, public std::enable_shared_fr
 
       explicit application_impl(application& self)
          : _self(self),
-           _chain_db(std::make_shared<chain::database>())
+           _chain_db(std::make_shared<chain::database>()),
+           _broadcast_confirmations(*_chain_db)
       {
       }
 
@@ -185,6 +187,8 @@ class application_impl : public net::node_delegate, public std::enable_shared_fr
 
       uint8_t get_current_block_interval_in_seconds() const override;
 
+      std::shared_ptr<const net::known_items_filter> get_known_items_filter() const override;
+
       /// Add an available plugin
       void add_available_plugin( std::shared_ptr<abstract_plugin> p );
 
@@ -215,6 +219,10 @@ class application_impl : public net::node_delegate, public std::enable_shared_fr
       api_access _apiaccess;
 
       std::shared_ptr<graphene::chain::database>            _chain_db;
+      broadcast_confirmation_registry                       _broadcast_confirmations;
+      /// Blocks and transactions known to the chain, for the p2p thread
+      std::shared_ptr<net::known_items_filter>              _known_items = std::make_shared<net::known_items_filter>();
+      boost::signals2::scoped_connection                    _known_items_connection;
       std::shared_ptr<graphene::net::node>                  _p2p_network;
       std::shared_ptr<fc::http::websocket_server>      _websocket_server;
       std::shared_ptr<fc::http::websocket_tls_server>  _websocket_tls_server;
@@ -227,6 +235,9 @@ class application_impl : public net::node_delegate, public std::enable_shared_fr
       /// A string defined by the node operator, which can be retrieved via the login_api::get_info API
       string _node_info;
 
+      /// The file to write the apply profile of the chain database to
+      fc::optional<fc::path> _apply_profile_file;
+
       fc::serial_valve valve;
    };
 
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/app/broadcast_confirmation_registry.hpp>
+
+#include <algorithm>
+
+namespace graphene { namespace app {
+
+broadcast_confirmation_registry::broadcast_confirmation_registry( chain::database& db )
+{
+   _applied_block_connection = db.applied_block.connect( [this,&db]( const chain::signed_block& b ) {
+      on_applied_block( b, db.get_applied_transaction_results() );
+   });
+}
+
+uint64_t broadcast_confirmation_registry::new_session()
+{
+   return ++_next_session;
+}
+
+broadcast_confirmation_registry::shard& broadcast_confirmation_registry::get_shard(
+      const chain::transaction_id_type& trx_id )
+{
+   return _shards[ std::hash<fc::ripemd160>()( trx_id ) % shard_count ];
+}
+
+void broadcast_confirmation_registry::add( uint64_t session, const chain::transaction_id_type& trx_id,
+                                           const fc::time_point_sec expiration, callback_type callback )
+{
+   shard& s = get_shard( trx_id );
+   std::lock_guard<std::mutex> guard( s.mutex );
+   auto& entries = s.callbacks[trx_id];
+   if( entries.empty() )
+      s.expirations.emplace( expiration, trx_id );
+   entries.push_back( entry{ session, std::move(callback) } );
+   ++_size;
+}
+
+void broadcast_confirmation_registry::remove_session( uint64_t session )
+{
+   if( 0 == _size.load() )
+      return;
+   for( shard& s : _shards )
+   {
+      std::lock_guard<std::mutex> guard( s.mutex );
+      for( auto itr = s.callbacks.begin(); itr != s.callbacks.end(); )
+      {
+         auto& entries = itr->second;
+         const auto old_size = entries.size();
+         entries.erase( std::remove_if( entries.begin(), entries.end(),
+                                        [session]( const entry& e ) { return e.session == session; } ),
+                        entries.end() );
+         _size -= old_size - entries.size();
+         // The expiration entry is left in place and dropped when the transaction expires
+         if( entries.empty() )
+            itr = s.callbacks.erase( itr );
+         else
+            ++itr;
+      }
+   }
+}
+
+void broadcast_confirmation_registry::on_applied_block( const chain::signed_block& b,
+      const std::vector<std::vector<chain::operation_result>>& trx_results )
+{
+   if( 0 == _size.load() )
+      return;
+
+   // Take the matching callbacks out of the shards first, so that they are called without holding any lock
+   std::vector<std::pair<uint32_t, std::vector<entry>>> matched;
+   for( uint32_t trx_num = 0; trx_num < b.transactions.size(); ++trx_num )
+   {
+      const auto& trx_id = b.transactions[trx_num].id();
+      shard& s = get_shard( trx_id );
+      std::lock_guard<std::mutex> guard( s.mutex );
+      auto itr = s.callbacks.find( trx_id );
+      if( itr == s.callbacks.end() )
+         continue;
+      _size -= itr->second.size();
+      matched.emplace_back( trx_num, std::move( itr->second ) );
+      s.callbacks.erase( itr );
+   }
+
+   // Transactions expiring before the block time can not be included in later blocks. Those expiring at the block
+   // time are kept, a block with the same time on another fork may still include them.
+   for( shard& s : _shards )
+   {
+      std::lock_guard<std::mutex> guard( s.mutex );
+      auto end = s.expirations.lower_bound( b.timestamp );
+      for( auto itr = s.expirations.begin(); itr != end; ++itr )
+      {
+         auto cb_itr = s.callbacks.find( itr->second );
+         if( cb_itr == s.callbacks.end() )
+            continue;
+         _size -= cb_itr->second.size();
+         s.callbacks.erase( cb_itr );
+      }
+      s.expirations.erase( s.expirations.begin(), end );
+   }
+
+   for( const auto& item : matched )
+      for( const entry& e : item.second )
+         e.callback( b, item.first, trx_results[item.first] );
+}
+
+} } // graphene::app
@@ -29,7 +29,7 @@
 #include <graphene/app/util.hpp>
 #include <graphene/chain/get_config.hpp>
 #include <graphene/chain/hardfork.hpp>
-#include <graphene/protocol/pts_address.hpp>
+#include <graphene/protocol/key_addresses.hpp>
 #include <graphene/protocol/restriction_predicate.hpp>
 
 #include <fc/crypto/hex.hpp>
@@ -411,15 +411,9 @@ vector<flat_set<account_id_type>> database_api_impl::get_key_references( vector<
 
    for( auto& key : keys )
    {
-      address a1( pts_address(key, false) ); // version = 56 (default)
-      address a2( pts_address(key, true) ); // version = 56 (default)
-      address a3( pts_address(key, false, 0)  );
-      address a4( pts_address(key, true, 0)  );
-      address a5( key );
-
       flat_set<account_id_type> result;
 
-      for( auto& a : {a1,a2,a3,a4,a5} )
+      for( const auto& a : get_key_addresses( key ) )
       {
           auto itr = refs.account_to_address_memberships.find(a);
           if( itr != refs.account_to_address_memberships.end() )
@@ -516,7 +510,12 @@ vector<optional<account_object>> database_api_impl::get_accounts( const vector<s
 std::map<string, full_account, std::less<>> database_api::get_full_accounts( const vector<string>& names_or_ids,
                                                                              const optional<bool>& subscribe )const
 {
-   return my->get_full_accounts( names_or_ids, subscribe );
+   // Subscribing is not thread safe, so only the calls without subscriptions run on read-only worker threads
+   if( my->get_whether_to_subscribe( subscribe ) )
+      return my->get_full_accounts( names_or_ids, subscribe );
+   return my->_db.run_read_only( [this,&names_or_ids]() {
+      return my->get_full_accounts( names_or_ids, false );
+   });
 }
 
 std::map<std::string, full_account, std::less<>> database_api_impl::get_full_accounts(
@@ -1052,7 +1051,7 @@ vector<optional<extended_asset_object>> database_api_impl::lookup_asset_symbols(
 
 vector<limit_order_object> database_api::get_limit_orders(std::string a, std::string b, uint32_t limit)const
 {
-   return my->get_limit_orders( a, b, limit );
+   return my->_db.run_read_only( [this,&a,&b,limit]() { return my->get_limit_orders( a, b, limit ); } );
 }
 
 vector<limit_order_object> database_api_impl::get_limit_orders( const std::string& a, const std::string& b,
@@ -1114,7 +1113,9 @@ vector<limit_order_object> database_api::get_account_limit_orders(
                               const string& account_name_or_id, const string &base, const string &quote,
                               uint32_t limit, optional<limit_order_id_type> ostart_id, optional<price> ostart_price )
 {
-   return my->get_account_limit_orders( account_name_or_id, base, quote, limit, ostart_id, ostart_price );
+   return my->_db.run_read_only( [&,this]() {
+      return my->get_account_limit_orders( account_name_or_id, base, quote, limit, ostart_id, ostart_price );
+   });
 }
 
 vector<limit_order_object> database_api_impl::get_account_limit_orders(
@@ -1444,7 +1445,7 @@ market_volume database_api_impl::get_24_volume( const string& base, const string
 
 order_book database_api::get_order_book( const string& base, const string& quote, uint32_t limit )const
 {
-   return my->get_order_book( base, quote, limit );
+   return my->_db.run_read_only( [this,&base,&quote,limit]() { return my->get_order_book( base, quote, limit ); } );
 }
 
 order_book database_api_impl::get_order_book( const string& base, const string& quote, uint32_t limit )const
@@ -1530,7 +1531,9 @@ vector<market_trade> database_api::get_trade_history( const string& base,
                                                       fc::time_point_sec stop,
                                                       uint32_t limit )const
 {
-   return my->get_trade_history( base, quote, start, stop, limit );
+   return my->_db.run_read_only( [this,&base,&quote,start,stop,limit]() {
+      return my->get_trade_history( base, quote, start, stop, limit );
+   });
 }
 
 vector<market_trade> database_api_impl::get_trade_history( const string& base,
@@ -309,7 +309,41 @@ namespace graphene { namespace app {
    class block_api
    {
    public:
-      explicit block_api(const graphene::chain::database& db);
+      explicit block_api(application& app);
+
+      /// The part of each block to return from @ref get_block_range
+      enum class block_content
+      {
+         full,           ///< The whole signed block
+         header,         ///< The signed block header only
+         transaction_ids ///< The IDs of the transactions in the block only
+      };
+
+      /// How to encode each block or block header returned from @ref get_block_range
+      enum class block_encoding
+      {
+         object, ///< As an object
+         hex,    ///< Packed with the binary serialization of the chain, as a hex string
+         base64  ///< Packed with the binary serialization of the chain, as a base64 string
+      };
+
+      struct block_range_item
+      {
+         uint32_t                              block_num = 0;
+         block_id_type                         block_id;
+         optional<signed_block>                block;
+         optional<signed_block_header>         header;
+         /// The packed block or block header if a binary encoding is requested
+         optional<string>                      raw;
+         optional<vector<transaction_id_type>> transaction_ids;
+      };
+
+      struct block_range
+      {
+         vector<block_range_item> blocks;
+         /// The block number to query for the next page, or null if the head block has been returned
+         optional<uint32_t>       next_block_num;
+      };
 
       /**
           * @brief Get signed blocks
@@ -319,7 +353,30 @@ namespace graphene { namespace app {
           */
       vector<optional<signed_block>> get_blocks(uint32_t block_num_from, uint32_t block_num_to)const;
 
+      /**
+          * @brief Get a page of consecutive blocks, optionally in binary form and reduced to a subset of their data
+          * @param start_block_num The lowest block number to return
+          * @param limit Maximum number of blocks to return, must not exceed the configured value of
+          *              @a api_limit_get_block_range
+          * @param content The part of each block to return, see @ref block_content
+          * @param encoding How to encode each block or block header, see @ref block_encoding
+          * @return The blocks found, and the block number to start the next page from
+          *
+          * @note
+          * 1. With a binary encoding, blocks are returned as they are stored in the block database, without
+          *    unpacking them, which is much cheaper than converting them to objects.
+          * 2. @p encoding is ignored if @p content is @a transaction_ids.
+          * 3. @p limit can be omitted or be @a null, if so the configured value of
+          *       @a api_limit_get_block_range will be used.
+          * 4. Optional parameters can be omitted from the end of the parameter list.
+          */
+      block_range get_block_range( uint32_t start_block_num,
+                                   const optional<uint32_t>& limit = optional<uint32_t>(),
+                                   const optional<block_content>& content = optional<block_content>(),
+                                   const optional<block_encoding>& encoding = optional<block_encoding>() )const;
+
    private:
+      application& _app;
       const graphene::chain::database& _db;
    };
 
@@ -331,6 +388,7 @@ namespace graphene { namespace app {
    {
       public:
          explicit network_broadcast_api(application& a);
+         ~network_broadcast_api();
 
          struct transaction_confirmation
          {
@@ -375,16 +433,16 @@ namespace graphene { namespace app {
          /**
           * @brief Not reflected, thus not accessible to API clients.
           *
-          * This function is registered to receive the applied_block
-          * signal from the chain database when a block is received.
-          * It then dispatches callbacks to clients who have requested
-          * to be notified when a particular txid is included in a block.
+          * This function is called by the application-wide registry of broadcast confirmations when a transaction
+          * which has been broadcast with a callback is included in a block.
+          * It then dispatches the callback to the client.
           */
-         void on_applied_block( const signed_block& b );
+         void on_confirmation( const signed_block& b, uint32_t trx_num, const vector<operation_result>& results,
+                               const confirmation_callback& callback );
       private:
-         boost::signals2::scoped_connection             _applied_block_connection;
-         map<transaction_id_type,confirmation_callback> _callbacks;
          application&                                   _app;
+         /// The session ID of the callbacks registered by this API instance
+         uint64_t                                       _session;
    };
 
    /**
@@ -429,6 +487,29 @@ namespace graphene { namespace app {
           */
          std::vector<net::potential_peer_record> get_potential_peers() const;
 
+         /**
+          * @brief Get latency statistics of applied operations, evaluator phases and block processing steps
+          * @return the statistics collected since the node started or the last reset
+          * @note Only available if the node is started with the enable-apply-profiler option
+          */
+         chain::apply_profile get_apply_profile() const;
+
+         /**
+          * @brief Discard the collected apply latency statistics
+          */
+         void reset_apply_profile();
+
+         /**
+          * @brief Write the collected apply latency statistics to the file specified by the apply-profile-file
+          *        option of the node
+          */
+         void dump_apply_profile() const;
+
+         /**
+          * @brief Get the number and estimated memory usage of blocks in the fork database
+          */
+         chain::fork_database_metrics get_fork_db_metrics() const;
+
       private:
          application& _app;
    };
@@ -616,6 +697,21 @@ namespace graphene { namespace app {
             share_type    total_for_sale; ///< total amount of asset for sale, asset id is min_price.base.asset_id
          };
 
+         /**
+          * @brief summary data of a group of limit orders with the depth of the order book down to the group
+          */
+         struct limit_order_group_depth : limit_order_group
+         {
+            limit_order_group_depth( const limit_order_group& g, share_type cumulative )
+               :  limit_order_group( g ), cumulative_for_sale( cumulative )
+                  {}
+            limit_order_group_depth() = default;
+
+            /// total amount for sale in this group and all groups with better prices, asset id is
+            /// min_price.base.asset_id
+            share_type    cumulative_for_sale;
+         };
+
          /**
           * @brief Get tracked groups configured by the server.
           * @return A list of numbers which indicate configured groups, of those, 1 means 0.01% diff on price.
@@ -639,6 +735,25 @@ namespace graphene { namespace app {
                                                                const optional<price>& start,
                                                                uint32_t limit )const;
 
+         /**
+          * @brief Get grouped limit orders in given market along with the cumulative depth of the order book,
+          *        e.g. to draw a depth chart.
+          *
+          * @param base_asset symbol or ID of asset being sold
+          * @param quote_asset symbol or ID of asset being purchased
+          * @param group Maximum price diff within each order group, have to be one of configured values
+          * @param start Optional price to indicate the first order group to retrieve
+          * @param limit Maximum number of order groups to retrieve, must not exceed the configured value of
+          *              @a api_limit_get_grouped_limit_orders
+          * @return The grouped limit orders, ordered from best offered price to worst, each with the total amount
+          *         for sale in the group and all groups with better prices
+          */
+         vector< limit_order_group_depth > get_grouped_limit_order_depth( const std::string& base_asset,
+                                                                          const std::string& quote_asset,
+                                                                          uint16_t group,
+                                                                          const optional<price>& start,
+                                                                          uint32_t limit )const;
+
       private:
          application& _app;
    };
@@ -805,6 +920,12 @@ namespace graphene { namespace app {
 
 extern template class fc::api<graphene::app::login_api>;
 
+FC_REFLECT_ENUM( graphene::app::block_api::block_content, (full)(header)(transaction_ids) )
+FC_REFLECT_ENUM( graphene::app::block_api::block_encoding, (object)(hex)(base64) )
+FC_REFLECT( graphene::app::block_api::block_range_item,
+            (block_num)(block_id)(block)(header)(raw)(transaction_ids) )
+FC_REFLECT( graphene::app::block_api::block_range, (blocks)(next_block_num) )
+
 FC_REFLECT( graphene::app::network_broadcast_api::transaction_confirmation,
         (id)(block_num)(trx_num)(trx) )
 
@@ -818,6 +939,9 @@ FC_REFLECT( graphene::app::history_api::history_operation_detail,
 
 FC_REFLECT( graphene::app::orders_api::limit_order_group,
             (min_price)(max_price)(total_for_sale) )
+FC_REFLECT_DERIVED( graphene::app::orders_api::limit_order_group_depth,
+                    (graphene::app::orders_api::limit_order_group),
+                    (cumulative_for_sale) )
 
 FC_REFLECT( graphene::app::asset_api::account_asset_balance, (name)(account_id)(amount) )
 FC_REFLECT( graphene::app::asset_api::asset_holders, (asset_id)(count) )
@@ -838,6 +962,7 @@ FC_API(graphene::app::history_api,
      )
 FC_API(graphene::app::block_api,
        (get_blocks)
+       (get_block_range)
      )
 FC_API(graphene::app::network_broadcast_api,
        (broadcast_transaction)
@@ -852,6 +977,10 @@ FC_API(graphene::app::network_node_api,
        (get_potential_peers)
        (get_advanced_node_parameters)
        (set_advanced_node_parameters)
+       (get_apply_profile)
+       (reset_apply_profile)
+       (dump_apply_profile)
+       (get_fork_db_metrics)
      )
 FC_API(graphene::app::crypto_api,
        (blind)
@@ -870,6 +999,7 @@ FC_API(graphene::app::asset_api,
 FC_API(graphene::app::orders_api,
        (get_tracked_groups)
        (get_grouped_limit_orders)
+       (get_grouped_limit_order_depth)
      )
 FC_API(graphene::app::custom_operations_api,
        (get_storage_info)
@@ -34,6 +34,7 @@ namespace graphene { namespace app {
    using std::string;
 
    class abstract_plugin;
+   class broadcast_confirmation_registry;
 
    class application_options
    {
@@ -80,6 +81,7 @@ namespace graphene { namespace app {
          uint32_t api_limit_get_samet_funds = 101;
          uint32_t api_limit_get_credit_offers = 101;
          uint32_t api_limit_get_storage_info = 101;
+         uint32_t api_limit_get_block_range = 1000;
 
          static constexpr application_options get_default()
          {
@@ -140,6 +142,8 @@ namespace graphene { namespace app {
 
          net::node_ptr                    p2p_node();
          std::shared_ptr<chain::database> chain_database()const;
+         /// @return the registry of the callbacks waiting for transactions to be included in a block
+         broadcast_confirmation_registry& get_broadcast_confirmations();
          void set_api_limit();
          void set_block_production(bool producing_blocks);
          fc::optional< api_access_info > get_api_access_info( const string& username )const;
@@ -159,6 +163,9 @@ namespace graphene { namespace app {
 
          const string& get_node_info() const;
 
+         /// @return the file to write the apply profile to, if configured
+         const fc::optional<fc::path>& get_apply_profile_file() const;
+
    private:
          /// Add an available plugin
          void add_available_plugin( std::shared_ptr<abstract_plugin> p ) const;
@@ -212,6 +219,7 @@ FC_REFLECT( graphene::app::application_options,
             ( api_limit_get_samet_funds )
             ( api_limit_get_credit_offers )
             ( api_limit_get_storage_info )
+            ( api_limit_get_block_range )
           )
 
 GRAPHENE_DECLARE_EXTERNAL_SERIALIZATION( graphene::app::application_options )
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/chain/database.hpp>
+
+#include <boost/signals2/connection.hpp>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace graphene { namespace app {
+
+   /**
+    * @brief Application-wide registry of the callbacks waiting for transactions to be included in a block
+    *
+    * Each applied block is scanned once, and only the callbacks registered for the transactions in the block are
+    * dispatched. A callback is dropped after it has been dispatched, after the transaction has expired, or when the
+    * session which registered it is closed.
+    *
+    * The callbacks are kept in shards by transaction ID, so that registrations from different sessions rarely
+    * wait for each other.
+    */
+   class broadcast_confirmation_registry
+   {
+      public:
+         /// Called with the block which contains the transaction, the position of the transaction in the block and
+         /// the results of its operations
+         using callback_type = std::function<void( const chain::signed_block&, uint32_t,
+                                                   const std::vector<chain::operation_result>& )>;
+
+         explicit broadcast_confirmation_registry( chain::database& db );
+
+         /// @return a new session ID to register callbacks with
+         uint64_t new_session();
+
+         /// Register a callback for the transaction with the given ID and expiration time
+         void add( uint64_t session, const chain::transaction_id_type& trx_id, const fc::time_point_sec expiration,
+                   callback_type callback );
+
+         /// Drop all callbacks registered by a session
+         void remove_session( uint64_t session );
+
+         /// @return the number of registered callbacks
+         size_t size()const { return _size.load(); }
+
+         /// Dispatch the callbacks of the transactions in the block and drop the ones of expired transactions
+         /// @param trx_results the results of the operations of each transaction in the block
+         void on_applied_block( const chain::signed_block& b,
+                                const std::vector<std::vector<chain::operation_result>>& trx_results );
+
+      private:
+         struct entry
+         {
+            uint64_t         session;
+            callback_type    callback;
+         };
+
+         struct shard
+         {
+            std::mutex mutex;
+            std::unordered_map<chain::transaction_id_type, std::vector<entry>, std::hash<fc::ripemd160>> callbacks;
+            std::multimap<fc::time_point_sec, chain::transaction_id_type> expirations;
+         };
+
+         static constexpr size_t shard_count = 16;
+
+         shard& get_shard( const chain::transaction_id_type& trx_id );
+
+         std::array<shard, shard_count>   _shards;
+         std::atomic<size_t>              _size { 0 };
+         std::atomic<uint64_t>            _next_session { 0 };
+
+         boost::signals2::scoped_connection _applied_block_connection;
+   };
+
+} } // graphene::app
@@ -105,6 +105,36 @@ void account_statistics_object::pay_fee( share_type core_fee, share_type cashbac
       pending_vested_fees += core_fee;
 }
 
+void account_authority_version_index::record_change( account_id_type id )
+{
+   ++_version;
+   _recent_changes.push_back( id );
+   if( _recent_changes.size() > max_recent_changes )
+      _recent_changes.pop_front();
+}
+
+void account_authority_version_index::object_removed( const object& obj )
+{
+   assert( dynamic_cast<const account_object*>(&obj) ); // for debug only
+   record_change( static_cast<const account_object&>(obj).get_id() );
+}
+
+void account_authority_version_index::about_to_modify( const object& before )
+{
+   assert( dynamic_cast<const account_object*>(&before) ); // for debug only
+   const account_object& a = static_cast<const account_object&>(before);
+   _before_owner = a.owner;
+   _before_active = a.active;
+}
+
+void account_authority_version_index::object_modified( const object& after )
+{
+   assert( dynamic_cast<const account_object*>(&after) ); // for debug only
+   const account_object& a = static_cast<const account_object&>(after);
+   if( a.owner != _before_owner || a.active != _before_active )
+      record_change( a.get_id() );
+}
+
 set<account_id_type> account_member_index::get_account_members(const account_object& a)const
 {
    set<account_id_type> result;
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/chain/apply_profiler.hpp>
+
+#include <graphene/protocol/operations.hpp>
+
+#include <fc/io/json.hpp>
+
+namespace graphene { namespace chain {
+
+namespace detail {
+
+   const char* const block_step_names[] = {
+      "apply_transactions",
+      "update_global_dynamic_data",
+      "process_tickets",
+      "perform_chain_maintenance",
+      "create_block_summary",
+      "clear_expired_transactions",
+      "clear_expired_proposals",
+      "clear_expired_orders",
+      "clear_expired_force_settlements",
+      "clear_expired_htlcs",
+      "update_expired_feeds",
+      "update_core_exchange_rates",
+      "update_withdraw_permissions",
+      "update_credit_offers_and_deals",
+      "update_witness_schedule",
+      "notify_applied_block",
+      "notify_changed_objects"
+   };
+   static_assert( sizeof(block_step_names) / sizeof(block_step_names[0])
+                     == size_t(apply_profiler::block_step::STEP_COUNT),
+                  "block_step_names does not match apply_profiler::block_step" );
+
+   struct operation_name_visitor
+   {
+      typedef std::string result_type;
+      template<typename T>
+      std::string operator()( const T& )const
+      {
+         std::string name = fc::get_typename<T>::name();
+         auto pos = name.rfind( ':' );
+         if( pos != std::string::npos )
+            name = name.substr( pos + 1 );
+         return name;
+      }
+   };
+
+   std::string operation_name( int which )
+   {
+      operation op;
+      op.set_which( which );
+      return op.visit( operation_name_visitor() );
+   }
+
+} // detail
+
+void latency_histogram::record( uint64_t ns )
+{
+   ++count;
+   total_ns += ns;
+   if( ns > max_ns )
+      max_ns = ns;
+   size_t bucket = 0;
+   while( ns > 1 && bucket + 1 < bucket_count )
+   {
+      ns >>= 1;
+      ++bucket;
+   }
+   ++buckets[bucket];
+}
+
+apply_profiler::apply_profiler()
+: _operations( operation::count() )
+{
+}
+
+void apply_profiler::record_operation( int which, uint64_t ns )
+{
+   if( which >= 0 && size_t(which) < _operations.size() )
+      _operations[which].total.record( ns );
+}
+
+void apply_profiler::record_phase( int which, evaluator_phase phase, uint64_t ns )
+{
+   if( which >= 0 && size_t(which) < _operations.size() )
+      _operations[which].phases[size_t(phase)].record( ns );
+}
+
+void apply_profiler::record_block_step( block_step step, uint64_t ns )
+{
+   _block_steps[size_t(step)].record( ns );
+}
+
+apply_profile apply_profiler::get_profile()const
+{
+   apply_profile result;
+   for( size_t which = 0; which < _operations.size(); ++which )
+   {
+      const operation_histograms& histograms = _operations[which];
+      if( 0 == histograms.total.count )
+         continue;
+      operation_latency_stats stats;
+      stats.operation = detail::operation_name( int(which) );
+      stats.total     = histograms.total;
+      stats.fee       = histograms.phases[size_t(evaluator_phase::fee)];
+      stats.evaluate  = histograms.phases[size_t(evaluator_phase::evaluate)];
+      stats.apply     = histograms.phases[size_t(evaluator_phase::apply)];
+      result.operations.push_back( std::move(stats) );
+   }
+   for( size_t step = 0; step < _block_steps.size(); ++step )
+   {
+      if( 0 == _block_steps[step].count )
+         continue;
+      result.block_steps.push_back( block_step_latency_stats{ detail::block_step_names[step], _block_steps[step] } );
+   }
+   return result;
+}
+
+void apply_profiler::reset()
+{
+   for( operation_histograms& histograms : _operations )
+      histograms = operation_histograms();
+   for( latency_histogram& histogram : _block_steps )
+      histogram = latency_histogram();
+}
+
+void apply_profiler::save_profile( const fc::path& file )const
+{
+   fc::json::save_to_file( get_profile(), file );
+}
+
+} } // graphene::chain
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/chain/chain_state_lock.hpp>
+
+#include <fc/thread/thread_specific.hpp>
+
+#include <algorithm>
+
+namespace graphene { namespace chain {
+
+namespace {
+   /// The address of this data identifies the current task, or the current thread outside of tasks
+   fc::task_specific_ptr<char> task_token;
+   /// Number of shared locks held by the current task
+   fc::task_specific_ptr<uint32_t> task_shared_lock_depth;
+
+   const void* current_task()
+   {
+      if( task_token.get() == nullptr )
+         task_token.reset( new char( 0 ) );
+      return task_token.get();
+   }
+
+   uint32_t& shared_lock_depth()
+   {
+      if( task_shared_lock_depth.get() == nullptr )
+         task_shared_lock_depth.reset( new uint32_t( 0 ) );
+      return *task_shared_lock_depth;
+   }
+
+   void wake( const std::vector<fc::promise<void>::ptr>& to_wake )
+   {
+      for( const auto& wake_up : to_wake )
+         wake_up->set_value();
+   }
+}
+
+void chain_state_lock::hand_over( std::vector<fc::promise<void>::ptr>& to_wake )
+{
+   if( _write_depth > 0 )
+      return;
+   if( !_waiting_writers.empty() )
+   {
+      if( _active_readers > 0 )
+         return;
+      _write_depth = 1;
+      _writer = _waiting_writers.front().task;
+      to_wake.push_back( std::move( _waiting_writers.front().wake_up ) );
+      _waiting_writers.pop_front();
+      return;
+   }
+   _active_readers += _waiting_readers.size();
+   to_wake.insert( to_wake.end(), _waiting_readers.begin(), _waiting_readers.end() );
+   _waiting_readers.clear();
+}
+
+void chain_state_lock::wait_for_hand_over( const fc::promise<void>::ptr& wake_up, bool exclusive )
+{
+   try
+   {
+      wake_up->wait();
+   }
+   catch( ... )
+   {
+      // E.g. the task has been canceled. Stop waiting, or give the lock back if it has been handed over already.
+      bool handed_over = false;
+      std::vector<fc::promise<void>::ptr> to_wake;
+      {
+         std::lock_guard<std::mutex> guard( _mutex );
+         if( exclusive )
+         {
+            auto itr = std::find_if( _waiting_writers.begin(), _waiting_writers.end(),
+                                     [&wake_up]( const waiting_writer& w ) { return w.wake_up == wake_up; } );
+            handed_over = ( itr == _waiting_writers.end() );
+            if( !handed_over )
+            {
+               _waiting_writers.erase( itr );
+               hand_over( to_wake );
+            }
+         }
+         else
+         {
+            auto itr = std::find( _waiting_readers.begin(), _waiting_readers.end(), wake_up );
+            handed_over = ( itr == _waiting_readers.end() );
+            if( !handed_over )
+               _waiting_readers.erase( itr );
+         }
+      }
+      wake( to_wake );
+      if( handed_over )
+      {
+         if( exclusive )
+            unlock_exclusive();
+         else
+            release_shared();
+      }
+      throw;
+   }
+}
+
+void chain_state_lock::lock_shared()
+{
+   fc::promise<void>::ptr wake_up;
+   {
+      std::lock_guard<std::mutex> guard( _mutex );
+      if( 0 == _write_depth && _waiting_writers.empty() )
+         ++_active_readers;
+      else
+      {
+         wake_up = fc::promise<void>::create( "chain_state_lock::lock_shared" );
+         _waiting_readers.push_back( wake_up );
+      }
+   }
+   if( wake_up )
+      wait_for_hand_over( wake_up, false );
+   ++shared_lock_depth();
+}
+
+void chain_state_lock::unlock_shared()
+{
+   --shared_lock_depth();
+   release_shared();
+}
+
+void chain_state_lock::release_shared()
+{
+   std::vector<fc::promise<void>::ptr> to_wake;
+   {
+      std::lock_guard<std::mutex> guard( _mutex );
+      --_active_readers;
+      hand_over( to_wake );
+   }
+   wake( to_wake );
+}
+
+void chain_state_lock::lock_exclusive()
+{
+   const void* const task = current_task();
+   fc::promise<void>::ptr wake_up;
+   {
+      std::lock_guard<std::mutex> guard( _mutex );
+      if( _write_depth > 0 && _writer == task )
+      {
+         ++_write_depth;
+         return;
+      }
+      if( 0 == _write_depth && 0 == _active_readers )
+      {
+         _write_depth = 1;
+         _writer = task;
+         return;
+      }
+      wake_up = fc::promise<void>::create( "chain_state_lock::lock_exclusive" );
+      _waiting_writers.push_back( { task, wake_up } );
+   }
+   wait_for_hand_over( wake_up, true );
+}
+
+void chain_state_lock::unlock_exclusive()
+{
+   std::vector<fc::promise<void>::ptr> to_wake;
+   {
+      std::lock_guard<std::mutex> guard( _mutex );
+      if( --_write_depth > 0 )
+         return;
+      _writer = nullptr;
+      hand_over( to_wake );
+   }
+   wake( to_wake );
+}
+
+bool chain_state_lock::is_writing_task()const
+{
+   const void* const task = current_task();
+   std::lock_guard<std::mutex> guard( _mutex );
+   return _write_depth > 0 && _writer == task;
+}
+
+bool chain_state_lock::is_reading_task()
+{
+   return shared_lock_depth() > 0;
+}
+
+} } // graphene::chain
@@ -28,6 +28,7 @@
 
 #include <graphene/chain/block_summary_object.hpp>
 #include <graphene/chain/global_property_object.hpp>
+#include <graphene/chain/impacted.hpp>
 #include <graphene/chain/operation_history_object.hpp>
 
 #include <graphene/chain/proposal_object.hpp>
@@ -82,30 +83,61 @@ optional<signed_block> database::fetch_block_by_number( uint32_t num )const
       return _block_id_to_block.fetch_by_number(num);
 }
 
-const signed_transaction& database::get_recent_transaction(const transaction_id_type& trx_id) const
+optional<vector<char>> database::fetch_raw_block_by_number( uint32_t num )const
 {
-   auto& index = get_index_type<transaction_index>().indices().get<by_trx_id>();
-   auto itr = index.find(trx_id);
-   FC_ASSERT(itr != index.end());
-   return itr->trx;
+   auto results = _fork_db.fetch_block_by_number(num);
+   if( results.size() == 1 )
+      return fc::raw::pack( results[0]->data );
+   else
+      return _block_id_to_block.fetch_raw_by_number(num);
+}
+
+signed_transaction database::get_recent_transaction(const transaction_id_type& trx_id) const
+{
+   // The cache may still hold transactions which have been popped or failed, only those in the chain state count
+   const auto& trx_idx = get_index_type<transaction_index>().indices().get<by_trx_id>();
+   auto history_itr = trx_idx.find( trx_id );
+   FC_ASSERT( history_itr != trx_idx.end() );
+   auto trx = _recent_transactions.find( trx_id );
+   if( trx.valid() )
+      return std::move( *trx );
+
+   // The cache is not saved with the chain state and drops transactions beyond its size limit,
+   // so it is filled from the block of the transaction when needed
+   optional<signed_block> block = fetch_block_by_number( history_itr->block_num );
+   FC_ASSERT( block.valid(), "Transaction has been dropped from the cache of recent transactions" );
+   for( const processed_transaction& block_trx : block->transactions )
+   {
+      if( block_trx.id() == trx_id )
+      {
+         _recent_transactions.add( trx_id, block_trx );
+         return block_trx;
+      }
+   }
+   FC_THROW( "Transaction has been dropped from the cache of recent transactions" );
+}
+
+void database::set_recent_transaction_cache_size( uint64_t max_size )
+{
+   _recent_transactions.set_max_size( max_size );
 }
 
 std::vector<block_id_type> database::get_block_ids_on_fork(block_id_type head_of_fork) const
 {
-  pair<fork_database::branch_type, fork_database::branch_type> branches
-        = _fork_db.fetch_branch_from(head_block_id(), head_of_fork);
-  if( !((branches.first.back()->previous_id() == branches.second.back()->previous_id())) )
+  // Only the branch of the fork is walked, the common ancestor is found with skip pointers
+  const item_ptr ancestor = _fork_db.fetch_common_ancestor( head_block_id(), head_of_fork );
+  std::vector<block_id_type> result;
+  item_ptr fork_block = _fork_db.fetch_block( head_of_fork );
+  while( fork_block != ancestor )
   {
-     edump( (head_of_fork)
-            (head_block_id())
-            (branches.first.size())
-            (branches.second.size()) );
-     assert(branches.first.back()->previous_id() == branches.second.back()->previous_id());
+    result.emplace_back( fork_block->id );
+    fork_block = fork_block->prev.lock();
+    FC_ASSERT( fork_block, "Fork is not linked to its common ancestor with the head block" );
   }
-  std::vector<block_id_type> result;
-  for (const item_ptr& fork_block : branches.second)
-    result.emplace_back(fork_block->id);
-  result.emplace_back(branches.first.back()->previous_id());
+  result.emplace_back( ancestor->id );
+  // If one of the blocks is on the branch of the other, the branches end with that block
+  if( ancestor->id == head_of_fork || ancestor->id == head_block_id() )
+    result.emplace_back( ancestor->previous_id() );
   return result;
 }
 
@@ -117,6 +149,9 @@ std::vector<block_id_type> database::get_block_ids_on_fork(block_id_type head_of
  */
 bool database::push_block(const signed_block& new_block, uint32_t skip)
 {
+   // Yield to the observers of the previous block before any state is touched, not while a block is applied
+   wait_for_read_only_block_observers();
+   chain_state_lock::write_guard state_guard( _state_lock );
 //   idump((new_block.block_num())(new_block.id())(new_block.timestamp)(new_block.previous));
    bool result;
    detail::with_skip_flags( *this, skip, [&]()
@@ -269,6 +304,7 @@ void database::update_witnesses( fork_item& fork_entry )const
  */
 processed_transaction database::push_transaction( const precomputable_transaction& trx, uint32_t skip )
 { try {
+   chain_state_lock::write_guard state_guard( _state_lock );
    // see https://github.com/bitshares/bitshares-core/issues/1573
    FC_ASSERT( fc::raw::pack_size( trx ) < (1024 * 1024), "Transaction exceeds maximum transaction size." );
    processed_transaction result;
@@ -306,6 +342,7 @@ processed_transaction database::_push_transaction( const precomputable_transacti
 
 processed_transaction database::validate_transaction( const signed_transaction& trx )
 {
+   chain_state_lock::write_guard state_guard( _state_lock );
    auto session = _undo_db.start_undo_session();
    return _apply_transaction( trx );
 }
@@ -369,7 +406,7 @@ processed_transaction database::push_proposal(const proposal_object& proposal)
       else
       {
          _current_virtual_op = old_vop;
-         _applied_ops.resize( old_applied_ops_size );
+         _applied_ops.truncate( old_applied_ops_size );
       }
       wlog( "${e}", ("e",e.to_detail_string() ) );
       throw;
@@ -386,6 +423,8 @@ signed_block database::generate_block(
    uint32_t skip /* = 0 */
    )
 { try {
+   wait_for_read_only_block_observers();
+   chain_state_lock::write_guard state_guard( _state_lock );
    signed_block result;
    detail::with_skip_flags( *this, skip, [&]()
    {
@@ -443,9 +482,24 @@ signed_block database::_generate_block(
    size_t total_block_size = max_block_header_size;
 
    signed_block pending_block;
+   // The operation results of the transactions, for notifications if the state built here is reused
+   vector< vector<operation_result> > trx_results;
+
+   const bool reuse_state = can_reuse_generated_block_state();
+   const bool maint_needed = ( get_dynamic_global_properties().next_maintenance_time <= when );
 
    _pending_tx_session = _undo_db.start_undo_session();
 
+   // Set up the same context as _apply_block() does, so that the state built here equals the state built by
+   // applying the block, including the recorded operations
+   _applied_ops.clear();
+   _current_block_num    = head_block_num() + 1;
+   _current_trx_in_block = 0;
+   _current_block_time   = when;
+   _issue_453_affected_assets.clear();
+   _authority_check_cache.clear();
+   apply_profiler::lap_timer timer( _apply_profiler.get() );
+
    uint64_t postponed_tx_count = 0;
    for( const processed_transaction& tx : _pending_tx )
    {
@@ -458,10 +512,15 @@ signed_block database::_generate_block(
          continue;
       }
 
+      // Changes outside of the undo database which need to be reverted if the transaction is not included
+      const size_t old_applied_ops_size = _applied_ops.size();
+      const flat_set<asset_id_type> old_issue_453_affected_assets = _issue_453_affected_assets;
       try
       {
          auto temp_session = _undo_db.start_undo_session();
          processed_transaction ptx = _apply_transaction( tx );
+         if( reuse_state )
+            trx_results.push_back( std::move( ptx.operation_results ) );
          // Clear results to save disk space and network bandwidth.
          // This may break client applications which rely on the results.
          ptx.operation_results.clear();
@@ -473,6 +532,10 @@ signed_block database::_generate_block(
          // postpone transaction if it would make block too big
          if( new_total_size > maximum_block_size )
          {
+            if( reuse_state )
+               trx_results.pop_back();
+            _applied_ops.truncate( old_applied_ops_size );
+            _issue_453_affected_assets = old_issue_453_affected_assets;
             postponed_tx_count++;
             continue;
          }
@@ -481,9 +544,12 @@ signed_block database::_generate_block(
 
          total_block_size = new_total_size;
          pending_block.transactions.push_back( ptx );
+         ++_current_trx_in_block;
       }
       catch ( const fc::exception& e )
       {
+         _applied_ops.truncate( old_applied_ops_size );
+         _issue_453_affected_assets = old_issue_453_affected_assets;
          // Do nothing, transaction will not be re-applied
          wlog( "Transaction was not processed while generating block due to ${e}", ("e", e) );
          wlog( "The transaction was ${t}", ("t", tx) );
@@ -493,14 +559,7 @@ signed_block database::_generate_block(
    {
       wlog( "Postponed ${n} transactions due to block size limit", ("n", postponed_tx_count) );
    }
-
-   _pending_tx_session.reset();
-
-   // We have temporarily broken the invariant that
-   // _pending_tx_session is the result of applying _pending_tx, as
-   // _pending_tx now consists of the set of postponed transactions.
-   // However, the push_block() call below will re-create the
-   // _pending_tx_session.
+   timer.lap( apply_profiler::block_step::apply_transactions );
 
    pending_block.previous = head_block_id();
    pending_block.timestamp = when;
@@ -510,18 +569,98 @@ signed_block database::_generate_block(
    if( 0 == (skip & skip_witness_signature) )
       pending_block.sign( block_signing_private_key );
 
-   push_block( pending_block, skip | skip_transaction_signatures ); // skip authority check when pushing
-                                                                    // self-generated blocks
+   if( !reuse_state )
+   {
+      _pending_tx_session.reset();
+
+      // We have temporarily broken the invariant that
+      // _pending_tx_session is the result of applying _pending_tx, as
+      // _pending_tx now consists of the set of postponed transactions.
+      // However, the push_block() call below will re-create the
+      // _pending_tx_session.
+
+      push_block( pending_block, skip | skip_transaction_signatures ); // skip authority check when pushing
+                                                                       // self-generated blocks
+      return pending_block;
+   }
+
+   // The transactions of the block have been applied above in the same context as push_block() would apply them,
+   // so take over the state instead of undoing and applying them again, and only run the block level steps.
+   undo_database::session block_session = std::move( *_pending_tx_session );
+   _pending_tx_session.reset();
+   detail::with_skip_flags( *this, skip | skip_transaction_signatures, [&]()
+   {
+      detail::without_pending_transactions( *this, std::move(_pending_tx), [&]()
+      {
+         _push_generated_block( pending_block, std::move( trx_results ), std::move( block_session ),
+                                maint_needed, timer );
+      });
+   });
 
    return pending_block;
 } FC_CAPTURE_AND_RETHROW( (witness_id) ) } // GCOVR_EXCL_LINE
 
+bool database::can_reuse_generated_block_state()const
+{
+   if( !_reuse_generated_block_state )
+      return false;
+   // The generated block must become the new head of the fork database without switching forks
+   const auto fork_db_head = _fork_db.head();
+   if( !fork_db_head || fork_db_head->id != head_block_id() )
+      return false;
+   // apply_block() skips almost everything for blocks covered by checkpoints
+   if( !_checkpoints.empty() && _checkpoints.rbegin()->first > head_block_num() )
+      return false;
+   return true;
+}
+
+void database::_push_generated_block( const signed_block& new_block,
+                                      vector< vector<operation_result> >&& trx_results,
+                                      undo_database::session block_session,
+                                      bool maint_needed,
+                                      apply_profiler::lap_timer& timer )
+{ try {
+   uint32_t skip = get_node_properties().skip_flags;
+
+   // Same checks as _push_block()
+   const auto now = fc::time_point::now().sec_since_epoch();
+   if( new_block.timestamp.sec_since_epoch() > now - 86400 )
+   {
+      shared_ptr<fork_item> prev_block = _fork_db.fetch_block( new_block.previous );
+      GRAPHENE_ASSERT( prev_block, unlinkable_block_exception, "block does not link to known chain" );
+      if( prev_block->scheduled_witnesses && 0 == (skip&(skip_witness_schedule_check|skip_witness_signature)) )
+         verify_signing_witness( new_block, *prev_block );
+   }
+
+   const shared_ptr<fork_item> new_head = _fork_db.push_block(new_block);
+   FC_ASSERT( new_head->id == new_block.id(), "Generated block did not become the head of the fork database" );
+
+   try {
+      // The transactions may have changed the signing key of the witness, the signature has been checked against
+      // the key before the transactions were applied in _generate_block()
+      const witness_object& signing_witness = validate_block_header( skip | skip_witness_signature, new_block );
+
+      _applied_trx_results = std::move( trx_results );
+      _apply_block_steps( new_block, signing_witness, maint_needed, timer );
+
+      if( new_block.timestamp.sec_since_epoch() > now - 86400 )
+         update_witnesses( *new_head );
+      _block_id_to_block.store(new_block.id(), new_block);
+      block_session.commit();
+   } catch ( const fc::exception& e ) {
+      elog("Failed to push generated block:\n${e}", ("e", e.to_detail_string()));
+      _fork_db.remove( new_block.id() );
+      throw;
+   }
+} FC_CAPTURE_AND_RETHROW( (new_block) ) } // GCOVR_EXCL_LINE
+
 /**
  * Removes the most recent block from the database and
  * undoes any changes it made.
  */
 void database::pop_block()
 { try {
+   chain_state_lock::write_guard state_guard( _state_lock );
    _pending_tx_session.reset();
    auto fork_db_head = _fork_db.head();
    FC_ASSERT( fork_db_head, "Trying to pop() from empty fork database!?" );
@@ -540,6 +679,7 @@ void database::pop_block()
 
 void database::clear_pending()
 { try {
+   chain_state_lock::write_guard state_guard( _state_lock );
    assert( (_pending_tx.size() == 0) || _pending_tx_session.valid() );
    _pending_tx.clear();
    _pending_tx_session.reset();
@@ -547,8 +687,13 @@ void database::clear_pending()
 
 uint32_t database::push_applied_operation( const operation& op, bool is_virtual /* = true */ )
 {
-   _applied_ops.emplace_back( operation_history_object( op, _current_block_num, _current_trx_in_block,
-                                    _current_op_in_trx, _current_virtual_op, is_virtual, _current_block_time ) );
+   operation_history_object& entry = _applied_ops.append( op );
+   entry.block_num    = _current_block_num;
+   entry.trx_in_block = _current_trx_in_block;
+   entry.op_in_trx    = _current_op_in_trx;
+   entry.virtual_op   = _current_virtual_op;
+   entry.is_virtual   = is_virtual;
+   entry.block_time   = _current_block_time;
    ++_current_virtual_op;
    return _applied_ops.size() - 1;
 }
@@ -563,11 +708,16 @@ void database::set_applied_operation_result( uint32_t op_id, const operation_res
    }
 }
 
-const vector<optional< operation_history_object > >& database::get_applied_operations() const
+const applied_operation_log& database::get_applied_operations() const
 {
    return _applied_ops;
 }
 
+const vector< vector<operation_result> >& database::get_applied_transaction_results() const
+{
+   return _applied_trx_results;
+}
+
 //////////////////// private methods ////////////////////
 
 void database::apply_block( const signed_block& next_block, uint32_t skip )
@@ -595,10 +745,12 @@ void database::_apply_block( const signed_block& next_block )
    uint32_t next_block_num = next_block.block_num();
    uint32_t skip = get_node_properties().skip_flags;
    _applied_ops.clear();
+   _applied_trx_results.clear();
 
    if( 0 == (skip & skip_block_size_check) )
    {
-      FC_ASSERT( fc::raw::pack_size(next_block) <= get_global_properties().parameters.maximum_block_size );
+      // Calculated from the derived data which is filled by precompute_parallel() and shared with the merkle check
+      FC_ASSERT( next_block.get_packed_size() <= get_global_properties().parameters.maximum_block_size );
    }
 
    FC_ASSERT( (skip & skip_merkle_check) || next_block.transaction_merkle_root == next_block.calculate_merkle_root(),
@@ -624,9 +776,12 @@ void database::_apply_block( const signed_block& next_block )
    _current_block_time   = next_block.timestamp;
 
    _issue_453_affected_assets.clear();
+   _authority_check_cache.clear();
 
-   signed_block processed_block( next_block ); // make a copy
-   for( auto& trx : processed_block.transactions )
+   // The block is not copied, the operation results are kept next to it
+   apply_profiler::lap_timer timer( _apply_profiler.get() );
+   _applied_trx_results.reserve( next_block.transactions.size() );
+   for( const auto& trx : next_block.transactions )
    {
       /* We do not need to push the undo state for each transaction
        * because they either all apply and are valid or the
@@ -634,10 +789,18 @@ void database::_apply_block( const signed_block& next_block )
        * for transactions when validating broadcast transactions or
        * when building a block.
        */
-      trx.operation_results = apply_transaction( trx, skip ).operation_results;
+      _applied_trx_results.emplace_back( _apply_transaction_results( trx ) );
       ++_current_trx_in_block;
    }
+   timer.lap( apply_profiler::block_step::apply_transactions );
+
+   _apply_block_steps( next_block, signing_witness, maint_needed, timer );
+} FC_CAPTURE_AND_RETHROW( (next_block.block_num()) )  } // GCOVR_EXCL_LINE
 
+void database::_apply_block_steps( const signed_block& next_block,
+                                   const witness_object& signing_witness, bool maint_needed,
+                                   apply_profiler::lap_timer& timer )
+{
    _current_op_in_trx    = 0;
    _current_virtual_op   = 0;
 
@@ -645,23 +808,51 @@ void database::_apply_block( const signed_block& next_block )
    update_global_dynamic_data( next_block, missed );
    update_signing_witness(signing_witness, next_block);
    update_last_irreversible_block();
+   timer.lap( apply_profiler::block_step::update_global_dynamic_data );
+
+   // Objects whose deadlines have not passed need not be looked at, in most blocks nothing is due
+   using deadline_type = expiration_schedule::deadline_type;
+   auto is_due = [this]( deadline_type type ) {
+      return _expiration_schedule.is_due( type, head_block_time() );
+   };
 
-   process_tickets();
+   if( is_due( deadline_type::ticket ) )
+      process_tickets();
+   timer.lap( apply_profiler::block_step::process_tickets );
 
    // Are we at the maintenance interval?
    if( maint_needed )
+   {
       perform_chain_maintenance( next_block );
+      timer.lap( apply_profiler::block_step::perform_chain_maintenance );
+   }
 
    create_block_summary(next_block);
+   timer.lap( apply_profiler::block_step::create_block_summary );
    clear_expired_transactions();
-   clear_expired_proposals();
-   clear_expired_orders();
+   timer.lap( apply_profiler::block_step::clear_expired_transactions );
+   if( is_due( deadline_type::proposal ) )
+      clear_expired_proposals();
+   timer.lap( apply_profiler::block_step::clear_expired_proposals );
+   if( is_due( deadline_type::limit_order ) )
+      clear_expired_orders();
+   timer.lap( apply_profiler::block_step::clear_expired_orders );
+   // Not gated, because settle orders of globally settled assets are cancelled here before they are due
    clear_expired_force_settlements();
-   clear_expired_htlcs();
+   timer.lap( apply_profiler::block_step::clear_expired_force_settlements );
+   if( is_due( deadline_type::htlc ) )
+      clear_expired_htlcs();
+   timer.lap( apply_profiler::block_step::clear_expired_htlcs );
    update_expired_feeds();       // this will update expired feeds and some core exchange rates
+   timer.lap( apply_profiler::block_step::update_expired_feeds );
    update_core_exchange_rates(); // this will update remaining core exchange rates
-   update_withdraw_permissions();
-   update_credit_offers_and_deals();
+   timer.lap( apply_profiler::block_step::update_core_exchange_rates );
+   if( is_due( deadline_type::withdraw_permission ) )
+      update_withdraw_permissions();
+   timer.lap( apply_profiler::block_step::update_withdraw_permissions );
+   if( is_due( deadline_type::credit_offer ) || is_due( deadline_type::credit_deal ) )
+      update_credit_offers_and_deals();
+   timer.lap( apply_profiler::block_step::update_credit_offers_and_deals );
 
    // n.b., update_maintenance_flag() happens this late
    // because get_slot_time() / get_slot_at_time() is needed above
@@ -670,15 +861,21 @@ void database::_apply_block( const signed_block& next_block )
    // to be called for header validation?
    update_maintenance_flag( maint_needed );
    update_witness_schedule();
+   timer.lap( apply_profiler::block_step::update_witness_schedule );
    if( !_node_property_object.debug_updates.empty() )
       apply_debug_updates();
 
    // notify observers that the block has been applied
-   notify_applied_block( processed_block ); //emit
+   timer.skip();
+   notify_applied_block( next_block ); //emit
+   notify_read_only_block_observers( next_block );
+   timer.lap( apply_profiler::block_step::notify_applied_block );
    _applied_ops.clear();
+   _applied_trx_results.clear();
 
    notify_changed_objects();
-} FC_CAPTURE_AND_RETHROW( (next_block.block_num()) )  } // GCOVR_EXCL_LINE
+   timer.lap( apply_profiler::block_step::notify_changed_objects );
+}
 
 /**
  * @note if a @c processed_transaction is passed in, it is cast into @c signed_transaction here.
@@ -695,7 +892,25 @@ processed_transaction database::apply_transaction(const signed_transaction& trx,
    return result;
 }
 
+authority_check_cache& database::get_authority_check_cache()
+{
+   const uint64_t version = _account_authority_versions->get_version();
+   if( version != _authority_check_cache_version )
+   {
+      _authority_check_cache.clear();
+      _authority_check_cache_version = version;
+   }
+   return _authority_check_cache;
+}
+
 processed_transaction database::_apply_transaction(const signed_transaction& trx)
+{
+   processed_transaction ptrx(trx);
+   ptrx.operation_results = _apply_transaction_results( trx );
+   return ptrx;
+}
+
+vector<operation_result> database::_apply_transaction_results( const signed_transaction& trx )
 { try {
    uint32_t skip = get_node_properties().skip_flags;
 
@@ -725,7 +940,8 @@ processed_transaction database::_apply_transaction(const signed_transaction& trx
 
       trx.verify_authority(chain_id, get_active, get_owner, get_custom, allow_non_immediate_owner,
                            MUST_IGNORE_CUSTOM_OP_REQD_AUTHS(head_block_time()),
-                           get_global_properties().parameters.max_authority_depth);
+                           get_global_properties().parameters.max_authority_depth,
+                           &get_authority_check_cache());
    }
 
    //Skip all manner of expiration and TaPoS checking if we're on block 1; It's impossible that the transaction is
@@ -754,31 +970,33 @@ processed_transaction database::_apply_transaction(const signed_transaction& trx
    //Insert transaction into unique transactions database.
    if( 0 == (skip & skip_transaction_dupe_check) )
    {
-      create<transaction_history_object>([&trx](transaction_history_object& transaction) {
+      create<transaction_history_object>([this,&trx](transaction_history_object& transaction) {
          transaction.trx_id = trx.id();
-         transaction.trx = trx;
+         transaction.expiration = trx.expiration;
+         transaction.block_num = head_block_num() + 1;
+         transaction_get_impacted_accounts( trx, transaction.impacted_accounts,
+                                            MUST_IGNORE_CUSTOM_OP_REQD_AUTHS( head_block_time() ) );
       });
+      _recent_transactions.add( trx.id(), trx );
    }
 
    eval_state.operation_results.reserve(trx.operations.size());
 
    //Finally process the operations
-   processed_transaction ptrx(trx);
    _current_op_in_trx = 0;
-   for( const auto& op : ptrx.operations )
+   for( const auto& op : trx.operations )
    {
       _current_virtual_op = 0;
       eval_state.operation_results.emplace_back(apply_operation(eval_state, op, false)); // This is NOT a virtual op
       ++_current_op_in_trx;
    }
-   ptrx.operation_results = std::move(eval_state.operation_results);
 
    // Make sure there is no unpaid samet fund debt
    const auto& samet_fund_idx = get_index_type<samet_fund_index>().indices().get<by_unpaid>();
    FC_ASSERT( samet_fund_idx.empty() || samet_fund_idx.begin()->unpaid_amount == 0,
               "Unpaid SameT Fund debt detected" );
 
-   return ptrx;
+   return std::move( eval_state.operation_results );
 } FC_CAPTURE_AND_RETHROW( (trx) ) } // GCOVR_EXCL_LINE
 
 operation_result database::apply_operation( transaction_evaluation_state& eval_state, const operation& op,
@@ -791,7 +1009,9 @@ operation_result database::apply_operation( transaction_evaluation_state& eval_s
    unique_ptr<op_evaluator>& eval = _operation_evaluators[ u_which ];
    FC_ASSERT( eval, "No registered evaluator for operation ${op}", ("op",op) );
    auto op_id = push_applied_operation( op, is_virtual );
+   apply_profiler::lap_timer timer( _apply_profiler.get() );
    auto result = eval->evaluate( eval_state, op, true );
+   timer.lap( i_which );
    set_applied_operation_result( op_id, result );
    return result;
 } FC_CAPTURE_AND_RETHROW( (op) ) } // GCOVR_EXCL_LINE
@@ -819,7 +1039,7 @@ operation_result database::try_push_virtual_operation( transaction_evaluation_st
       wlog( "Failed to push virtual operation ${op} at block ${n}; exception was ${e}",
             ("op", op)("n", head_block_num())("e", e.to_detail_string()) );
       _current_virtual_op = old_vop;
-      _applied_ops.resize( old_applied_ops_size );
+      _applied_ops.truncate( old_applied_ops_size );
       throw;
    }
 }
@@ -885,31 +1105,64 @@ void database::_precompute_parallel( const Trx* trx, const size_t count, const u
    }
 }
 
+void database::_precompute_block_transactions( const processed_transaction* trx, const size_t count,
+                                              const uint32_t skip, transaction_derived_data* derived )const
+{
+   for( size_t i = 0; i < count; ++i, ++trx, ++derived )
+   {
+      // Also fills the cached ID and packed size of the transaction
+      *derived = trx->calculate_derived_data();
+      _precompute_parallel( trx, 1, skip );
+   }
+}
+
 fc::future<void> database::precompute_parallel( const signed_block& block, const uint32_t skip )const
 { try {
+   // The data derived from the transactions covers their IDs, packed sizes and merkle leaves, and is shared
+   // with the p2p and API layers through the block. The workers fill in their parts, so it must not be used before
+   // the returned future has resolved.
+   const uint32_t derived_data_skip = skip_merkle_check | skip_transaction_dupe_check | skip_block_size_check;
+   std::shared_ptr<block_derived_data> derived_data;
+   if( !block.transactions.empty() && (skip & derived_data_skip) != derived_data_skip )
+   {
+      derived_data = std::make_shared<block_derived_data>();
+      derived_data->transactions.resize( block.transactions.size() );
+      block.set_derived_data( derived_data );
+   }
+
    std::vector<fc::future<void>> workers;
    if( !block.transactions.empty() )
    {
       if( (skip & skip_expensive) == skip_expensive )
-         _precompute_parallel( &block.transactions[0], block.transactions.size(), skip );
+      {
+         if( derived_data )
+            _precompute_block_transactions( &block.transactions[0], block.transactions.size(), skip,
+                                            &derived_data->transactions[0] );
+         else
+            _precompute_parallel( &block.transactions[0], block.transactions.size(), skip );
+      }
       else
       {
          uint32_t chunks = fc::asio::default_io_service_scope::get_num_threads();
          uint32_t chunk_size = ( block.transactions.size() + chunks - 1 ) / chunks;
          workers.reserve( chunks + 1 );
          for( size_t base = 0; base < block.transactions.size(); base += chunk_size )
-            workers.push_back( fc::do_parallel( [this,&block,base,chunk_size,skip] () {
-               _precompute_parallel( &block.transactions[base],
-                                     ( ( base + chunk_size ) < block.transactions.size() ) ? chunk_size
-                                                 : ( block.transactions.size() - base ),
-                                     skip );
+            workers.push_back( fc::do_parallel( [this,&block,base,chunk_size,skip,derived_data] () {
+               const size_t count = ( ( base + chunk_size ) < block.transactions.size() ) ? chunk_size
+                                                 : ( block.transactions.size() - base );
+               if( derived_data )
+                  _precompute_block_transactions( &block.transactions[base], count, skip,
+                                                  &derived_data->transactions[base] );
+               else
+                  _precompute_parallel( &block.transactions[base], count, skip );
             }) );
       }
    }
 
    if( 0 == (skip&skip_witness_signature) )
       workers.push_back( fc::do_parallel( [&block] () { block.signee(); } ) );
-   if( 0 == (skip&skip_merkle_check) )
+   // With derived data the merkle root is calculated from the merkle leaves on first use
+   if( 0 == (skip&skip_merkle_check) && !derived_data )
       block.calculate_merkle_root();
    block.id();
 
@@ -179,11 +179,12 @@ const call_order_object* database::find_least_collateralized_short( const asset_
    }
    else // after core-1270 hard fork, check with collateralization
    {
-      // Note: it is safe to check here even if there is no call order due to individual settlements
-      const auto& call_collateral_index = get_index_type<call_order_index>().indices().get<by_collateral>();
-      auto call_itr = call_collateral_index.lower_bound( call_min );
-      if( call_itr != call_collateral_index.end() ) // found a call order
-         call_ptr = &(*call_itr);
+      // Note: call orders always use the current backing asset as collateral,
+      //       because the backing asset can only be changed when there is no supply
+      const auto& call_orders = get_call_orders_by_collateral().get_call_orders( bitasset.asset_id,
+                                                                 bitasset.options.short_backing_asset );
+      if( !call_orders.empty() ) // found a call order
+         call_ptr = call_orders.begin()->order;
    }
    if( !call_ptr ) // not found
       return nullptr;
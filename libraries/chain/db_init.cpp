@@ -24,6 +24,8 @@
 
 #include <graphene/chain/database.hpp>
 
+#include <graphene/chain/expiration_schedule.hpp>
+
 #include <graphene/chain/account_object.hpp>
 #include <graphene/chain/asset_object.hpp>
 #include <graphene/chain/balance_object.hpp>
@@ -75,6 +77,29 @@
 
 namespace graphene { namespace chain {
 
+namespace detail {
+
+   time_point_sec proposal_deadline( const proposal_object& o ) { return o.expiration_time; }
+   time_point_sec limit_order_deadline( const limit_order_object& o ) { return o.expiration; }
+   time_point_sec htlc_deadline( const htlc_object& o ) { return o.conditions.time_lock.expiration; }
+   time_point_sec withdraw_permission_deadline( const withdraw_permission_object& o ) { return o.expiration; }
+   // disabled offers are not disabled again
+   time_point_sec credit_offer_deadline( const credit_offer_object& o )
+   { return o.enabled ? o.auto_disable_time : time_point_sec::maximum(); }
+   time_point_sec credit_deal_deadline( const credit_deal_object& o ) { return o.latest_repay_time; }
+   time_point_sec ticket_deadline( const ticket_object& o ) { return o.next_auto_update_time; }
+
+   template< typename ObjectType, expiration_schedule::deadline_type Type,
+             time_point_sec (*GetDeadline)( const ObjectType& ), typename PrimaryIndex >
+   void add_expiration_schedule_index( PrimaryIndex* idx, expiration_schedule& schedule )
+   {
+      // arguments are passed on by value, so wrap the schedule to hand over a reference to it
+      idx->template add_secondary_index< expiration_schedule_index< ObjectType, Type, GetDeadline > >(
+            std::ref( schedule ) );
+   }
+
+}
+
 void database::initialize_evaluators()
 {
    constexpr size_t max_num_of_evaluators = 255;
@@ -160,24 +185,47 @@ void database::initialize_indexes()
    add_index< primary_index<asset_index, 13> >(); // 8192 assets per chunk
    add_index< primary_index<force_settlement_index> >();
 
-   add_index< primary_index<account_index, 20> >(); // ~1 million accounts per chunk
+   auto acnt_idx = add_index< primary_index<account_index, 20> >(); // ~1 million accounts per chunk
+   _account_authority_versions = acnt_idx->add_secondary_index<account_authority_version_index>();
    add_index< primary_index<committee_member_index, 8> >(); // 256 members per chunk
    add_index< primary_index<witness_index, 10> >(); // 1024 witnesses per chunk
-   add_index< primary_index<limit_order_index > >();
-   add_index< primary_index<call_order_index > >();
-   add_index< primary_index<proposal_index > >();
-   add_index< primary_index<withdraw_permission_index > >();
+   auto limit_order_idx = add_index< primary_index<limit_order_index > >();
+   auto call_order_idx = add_index< primary_index<call_order_index > >();
+   _call_orders_by_collateral = call_order_idx->add_secondary_index<call_order_collateral_index>();
+   auto proposal_idx = add_index< primary_index<proposal_index > >();
+   _proposal_authorizations = proposal_idx->add_secondary_index<proposal_authorization_index>(
+         std::cref( *this ), std::cref( *_account_authority_versions ) );
+   auto withdraw_permission_idx = add_index< primary_index<withdraw_permission_index > >();
    add_index< primary_index<vesting_balance_index> >();
    add_index< primary_index<worker_index> >();
    add_index< primary_index<balance_index> >();
    add_index< primary_index<blinded_balance_index> >();
-   add_index< primary_index< htlc_index> >();
+   auto htlc_idx = add_index< primary_index< htlc_index> >();
    add_index< primary_index< custom_authority_index> >();
-   add_index< primary_index<ticket_index> >();
+   auto ticket_idx = add_index< primary_index<ticket_index> >();
    add_index< primary_index<liquidity_pool_index> >();
    add_index< primary_index<samet_fund_index> >();
-   add_index< primary_index<credit_offer_index> >();
-   add_index< primary_index<credit_deal_index> >();
+   auto credit_offer_idx = add_index< primary_index<credit_offer_index> >();
+   auto credit_deal_idx = add_index< primary_index<credit_deal_index> >();
+
+   // Deadlines of objects processed at the end of each block
+   using deadline_type = expiration_schedule::deadline_type;
+   _expiration_schedule.clear();
+   detail::add_expiration_schedule_index< proposal_object, deadline_type::proposal, detail::proposal_deadline >(
+         proposal_idx, _expiration_schedule );
+   detail::add_expiration_schedule_index< limit_order_object, deadline_type::limit_order,
+                                          detail::limit_order_deadline >( limit_order_idx, _expiration_schedule );
+   detail::add_expiration_schedule_index< htlc_object, deadline_type::htlc, detail::htlc_deadline >(
+         htlc_idx, _expiration_schedule );
+   detail::add_expiration_schedule_index< withdraw_permission_object, deadline_type::withdraw_permission,
+                                          detail::withdraw_permission_deadline >( withdraw_permission_idx,
+                                                                                  _expiration_schedule );
+   detail::add_expiration_schedule_index< credit_offer_object, deadline_type::credit_offer,
+                                          detail::credit_offer_deadline >( credit_offer_idx, _expiration_schedule );
+   detail::add_expiration_schedule_index< credit_deal_object, deadline_type::credit_deal,
+                                          detail::credit_deal_deadline >( credit_deal_idx, _expiration_schedule );
+   detail::add_expiration_schedule_index< ticket_object, deadline_type::ticket, detail::ticket_deadline >(
+         ticket_idx, _expiration_schedule );
 
    //Implementation object indexes
    add_index< primary_index<transaction_index                             > >();
@@ -187,7 +235,9 @@ void database::initialize_indexes()
 
    add_index< primary_index<asset_bitasset_data_index,                 13 > >(); // 8192
    add_index< primary_index<simple_index<global_property_object          >> >();
-   add_index< primary_index<simple_index<dynamic_global_property_object  >> >();
+   auto dyn_global_prop_idx = add_index< primary_index<simple_index<dynamic_global_property_object  >> >();
+   _hardfork_state = hardfork_state();
+   dyn_global_prop_idx->add_secondary_index<hardfork_state_index>( std::ref( _hardfork_state ) );
    add_index< primary_index<account_stats_index,                       20 > >(); // 1 Mi
    add_index< primary_index<simple_index<asset_dynamic_data_object       >> >();
    add_index< primary_index<simple_index<block_summary_object            >> >();
@@ -49,6 +49,7 @@ database::database()
 
 database::~database()
 {
+   wait_for_read_only_block_observers();
    clear_pending();
 }
 
@@ -147,7 +148,10 @@ void database::reindex( fc::path data_dir )
             ilog( "Done writing object database to disk" );
          }
          if( i < undo_point )
+         {
+            wait_for_read_only_block_observers();
             apply_block( block, skip );
+         }
          else
          {
             _undo_db.enable();
@@ -231,6 +235,7 @@ void database::close(bool rewinding)
 {
    if (!_opened)
       return;
+   wait_for_read_only_block_observers();
    // TODO:  Save pending tx's on close()
    clear_pending();
 
@@ -271,8 +276,32 @@ void database::close(bool rewinding)
       _block_id_to_block.close();
 
    _fork_db.reset();
+   _recent_transactions.clear();
 
    _opened = false;
 }
 
+void database::enable_apply_profiler(bool enable)
+{
+   if( !enable )
+      _apply_profiler.reset();
+   else if( !_apply_profiler )
+      _apply_profiler = std::make_unique<apply_profiler>();
+}
+
+void database::set_read_only_threads( uint16_t thread_count )
+{
+   _read_only_threads.clear();
+   _read_only_threads.reserve( thread_count );
+   for( uint16_t i = 0; i < thread_count; ++i )
+      _read_only_threads.push_back( std::make_unique<fc::thread>( "read_only_" + std::to_string(i) ) );
+}
+
+fc::thread* database::get_read_only_thread()const
+{
+   if( _read_only_threads.empty() || chain_state_lock::is_reading_task() || _state_lock.is_writing_task() )
+      return nullptr;
+   return _read_only_threads[ _next_read_only_thread++ % _read_only_threads.size() ].get();
+}
+
 } }
@@ -59,9 +59,9 @@ bool database::check_for_blackswan( const asset_object& mia, bool enable_black_s
 
     asset_id_type debt_asset_id = bitasset.asset_id;
 
-    auto maint_time = get_dynamic_global_properties().next_maintenance_time;
-    bool before_core_hardfork_1270 = ( maint_time <= HARDFORK_CORE_1270_TIME ); // call price caching issue
-    bool after_core_hardfork_2481 = HARDFORK_CORE_2481_PASSED( maint_time ); // Match settle orders with margin calls
+    const hardfork_state& hf = get_hardfork_state();
+    bool before_core_hardfork_1270 = !hf.core_1270_passed(); // call price caching issue
+    bool after_core_hardfork_2481 = hf.core_2481_passed(); // Match settle orders with margin calls
 
     // After core-2481 hard fork, if there are force-settlements, match call orders with them first
     if( after_core_hardfork_2481 )
@@ -118,7 +118,7 @@ bool database::check_for_blackswan( const asset_object& mia, bool enable_black_s
           highest = bitasset.median_feed.max_short_squeeze_price();
        else if( !before_core_hardfork_1270 )
           highest = bitasset.current_feed.max_short_squeeze_price();
-       else if( maint_time > HARDFORK_CORE_338_TIME )
+       else if( hf.core_338_passed() )
           highest = bitasset.current_feed.max_short_squeeze_price_before_hf_1270();
        // else do nothing
 
@@ -203,7 +203,7 @@ bool database::check_for_blackswan( const asset_object& mia, bool enable_black_s
           //     settle for less after GS, so they are incentivized to settle before GS which helps avoid GS.
           globally_settle_asset(mia, ~least_collateral, true );
        }
-       else if( maint_time > HARDFORK_CORE_338_TIME && ~least_collateral <= settle_price )
+       else if( hf.core_338_passed() && ~least_collateral <= settle_price )
           // global settle at feed price if possible
           globally_settle_asset(mia, settle_price );
        else
@@ -221,8 +221,8 @@ bool database::check_for_blackswan( const asset_object& mia, bool enable_black_s
 void database::globally_settle_asset( const asset_object& mia, const price& settlement_price,
                                       bool check_margin_calls )
 {
-   auto maint_time = get_dynamic_global_properties().next_maintenance_time;
-   bool before_core_hardfork_1669 = ( maint_time <= HARDFORK_CORE_1669_TIME ); // whether to use call_price
+   const hardfork_state& hf = get_hardfork_state();
+   bool before_core_hardfork_1669 = !hf.core_1669_passed(); // whether to use call_price
 
    if( before_core_hardfork_1669 )
    {
@@ -256,8 +256,8 @@ void database::globally_settle_asset_impl( const asset_object& mia,
    const asset_dynamic_data_object& mia_dyn = mia.dynamic_asset_data_id(*this);
    auto original_mia_supply = mia_dyn.current_supply;
 
-   auto maint_time = get_dynamic_global_properties().next_maintenance_time;
-   bool before_core_hardfork_342 = ( maint_time <= HARDFORK_CORE_342_TIME ); // better rounding
+   const hardfork_state& hf = get_hardfork_state();
+   bool before_core_hardfork_342 = !hf.core_342_passed(); // better rounding
 
    // cancel all call orders and accumulate it into collateral_gathered
    auto call_itr = call_index.lower_bound( price::min( bitasset.options.short_backing_asset, bitasset.asset_id ) );
@@ -362,8 +362,8 @@ void database::individually_settle( const asset_bitasset_data_object& bitasset,
 
    if( bsrm_type::individual_settlement_to_order == bsrm ) // settle to order
    {
-      const auto& head_time = head_block_time();
-      bool after_core_hardfork_2591 = HARDFORK_CORE_2591_PASSED( head_time ); // Tighter peg (fill debt order at MCOP)
+      const hardfork_state& hf = get_hardfork_state();
+      bool after_core_hardfork_2591 = hf.core_2591_passed(); // Tighter peg (fill debt order at MCOP)
 
       const limit_order_object* limit_ptr = find_settled_debt_order( bitasset.asset_id );
       if( limit_ptr )
@@ -498,7 +498,7 @@ void database::execute_bid( const collateral_bid_object& bid, share_type debt_co
          call.collateral = bid.inv_swan_price.base.amount + collateral_from_fund;
          call.debt = debt_covered;
          // don't calculate call_price after core-1270 hard fork
-         if( get_dynamic_global_properties().next_maintenance_time > HARDFORK_CORE_1270_TIME )
+         if( get_hardfork_state().core_1270_passed() )
             // bid.inv_swan_price is in collateral / debt
             call.call_price = price( asset( 1, bid.inv_swan_price.base.asset_id ),
                                      asset( 1, bid.inv_swan_price.quote.asset_id ) );
@@ -790,8 +790,8 @@ bool database::apply_order(const limit_order_object& new_order_object)
    // 5. the call order's collateral ratio is below or equals to MCR
    // 6. the limit order provided a good price
 
-   auto maint_time = get_dynamic_global_properties().next_maintenance_time;
-   bool before_core_hardfork_1270 = ( maint_time <= HARDFORK_CORE_1270_TIME ); // call price caching issue
+   const hardfork_state& hf = get_hardfork_state();
+   bool before_core_hardfork_1270 = !hf.core_1270_passed(); // call price caching issue
 
    bool to_check_call_orders = false;
    const asset_object& sell_asset = sell_asset_id( *this );
@@ -841,7 +841,8 @@ bool database::apply_order(const limit_order_object& new_order_object)
       {
          // check if there are margin calls
          // Note: it is safe to iterate here even if there is no call order due to individual settlements
-         const auto& call_collateral_idx = get_index_type<call_order_index>().indices().get<by_collateral>();
+         const auto& call_collateral_idx = get_call_orders_by_collateral().get_call_orders( sell_asset_id,
+                                                                                            recv_asset_id );
          // Note: when BSRM is no_settlement, current_feed can change after filled a call order,
          //       so we recalculate inside the loop
          using bsrm_type = bitasset_options::black_swan_response_type;
@@ -852,14 +853,14 @@ bool database::apply_order(const limit_order_object& new_order_object)
          {
             // hard fork core-343 and core-625 took place at same time,
             // always check call order with least collateral ratio
-            auto call_itr = call_collateral_idx.lower_bound( call_min );
-            if( call_itr == call_collateral_idx.end()
-                  || call_itr->debt_type() != sell_asset_id
+            if( call_collateral_idx.empty()
                   // feed protected https://github.com/cryptonomex/graphene/issues/436
-                  || call_itr->collateralization() > sell_abd->current_maintenance_collateralization )
+                  || call_collateral_idx.begin()->order->collateralization()
+                        > sell_abd->current_maintenance_collateralization )
                break;
+            const call_order_object& call_order = *call_collateral_idx.begin()->order;
             // hard fork core-338 and core-625 took place at same time, not checking HARDFORK_CORE_338_TIME here.
-            const auto match_result = match( new_order_object, *call_itr, call_match_price,
+            const auto match_result = match( new_order_object, call_order, call_match_price,
                                              *sell_abd, call_pays_price );
             // match returns 1 or 3 when the new order was fully filled.
             // In this case, we stop matching; otherwise keep matching.
@@ -945,18 +946,17 @@ void database::apply_force_settlement( const force_settlement_object& new_settle
                                        const asset_object& asset_obj )
 {
    // Defensive checks
-   auto maint_time = get_dynamic_global_properties().next_maintenance_time;
+   const hardfork_state& hf = get_hardfork_state();
    // GCOVR_EXCL_START
    // Defensive code, normally none of these should fail
-   FC_ASSERT( HARDFORK_CORE_2481_PASSED( maint_time ), "Internal error: hard fork core-2481 not passed" );
+   FC_ASSERT( hf.core_2481_passed(), "Internal error: hard fork core-2481 not passed" );
    FC_ASSERT( new_settlement.balance.asset_id == bitasset.asset_id, "Internal error: asset type mismatch" );
    FC_ASSERT( !bitasset.is_prediction_market, "Internal error: asset is a prediction market" );
    FC_ASSERT( !bitasset.is_globally_settled(), "Internal error: asset is globally settled already" );
    FC_ASSERT( !bitasset.current_feed.settlement_price.is_null(), "Internal error: no sufficient price feeds" );
    // GCOVR_EXCL_STOP
 
-   auto head_time = head_block_time();
-   bool after_core_hardfork_2582 = HARDFORK_CORE_2582_PASSED( head_time ); // Price feed issues
+   bool after_core_hardfork_2582 = hf.core_2582_passed(); // Price feed issues
 
    auto new_obj_id = new_settlement.id;
 
@@ -977,29 +977,28 @@ void database::apply_force_settlement( const force_settlement_object& new_settle
 
    // check if there are margin calls
    // Note: it is safe to iterate here even if there is no call order due to individual settlements
-   const auto& call_collateral_idx = get_index_type<call_order_index>().indices().get<by_collateral>();
-   auto call_min = price::min( bitasset.options.short_backing_asset, new_settlement.balance.asset_id );
+   const auto& call_collateral_idx = get_call_orders_by_collateral().get_call_orders(
+                                          new_settlement.balance.asset_id, bitasset.options.short_backing_asset );
    while( !finished )
    {
       // always check call order with the least collateral ratio
-      auto call_itr = call_collateral_idx.lower_bound( call_min );
-      // Note: we don't precalculate an iterator with upper_bound() before entering the loop,
-      //       because the upper bound can change after a call order got filled
-      if( call_itr == call_collateral_idx.end()
-            || call_itr->debt_type() != new_settlement.balance.asset_id
+      // Note: we don't keep an iterator across iterations, because filled call orders move in the index
+      if( call_collateral_idx.empty()
             // feed protected https://github.com/cryptonomex/graphene/issues/436
-            || call_itr->collateralization() > bitasset.current_maintenance_collateralization )
+            || call_collateral_idx.begin()->order->collateralization()
+                  > bitasset.current_maintenance_collateralization )
          break;
+      const call_order_object* call_ptr = call_collateral_idx.begin()->order;
       // TCR applies here
       auto settle_price = after_core_hardfork_2582 ? bitasset.median_feed.settlement_price
                                                    : bitasset.current_feed.settlement_price;
-      asset max_debt_to_cover( call_itr->get_max_debt_to_cover( call_pays_price,
+      asset max_debt_to_cover( call_ptr->get_max_debt_to_cover( call_pays_price,
                                                        settle_price,
                                                        bitasset.current_feed.maintenance_collateral_ratio,
                                                        bitasset.current_maintenance_collateralization ),
                                new_settlement.balance.asset_id );
 
-      match( new_settlement, *call_itr, call_pays_price, bitasset, max_debt_to_cover, call_match_price, true );
+      match( new_settlement, *call_ptr, call_pays_price, bitasset, max_debt_to_cover, call_match_price, true );
 
       // Check whether the new order is gone
       finished = ( nullptr == find_object( new_obj_id ) );
@@ -1068,8 +1067,8 @@ database::match_result_type database::match_limit_normal_limit( const limit_orde
    asset maker_pays;
    asset maker_receives;
 
-   auto maint_time = get_dynamic_global_properties().next_maintenance_time;
-   bool before_core_hardfork_342 = ( maint_time <= HARDFORK_CORE_342_TIME ); // better rounding
+   const hardfork_state& hf = get_hardfork_state();
+   bool before_core_hardfork_342 = !hf.core_342_passed(); // better rounding
 
    bool cull_taker = false;
    if( taker_for_sale <= ( maker_for_sale * match_price ) ) // rounding down here should be fine
@@ -1078,7 +1077,7 @@ database::match_result_type database::match_limit_normal_limit( const limit_orde
 
       // Be here, it's possible that taker is paying something for nothing due to partially filled in last loop.
       // In this case, we see it as filled and cancel it later
-      if( taker_receives.amount == 0 && maint_time > HARDFORK_CORE_184_TIME )
+      if( taker_receives.amount == 0 && hf.core_184_passed() )
          return match_result_type::only_taker_filled;
 
       if( before_core_hardfork_342 )
@@ -1175,8 +1174,8 @@ database::match_result_type database::match_limit_settled_debt( const limit_orde
    // seller, pays, receives, ...
    bool taker_filled = fill_limit_order( taker, call_receives, order_receives, cull_taker, match_price, false );
 
-   const auto& head_time = head_block_time();
-   bool after_core_hardfork_2591 = HARDFORK_CORE_2591_PASSED( head_time ); // Tighter peg (fill debt order at MCOP)
+   const hardfork_state& hf = get_hardfork_state();
+   bool after_core_hardfork_2591 = hf.core_2591_passed(); // Tighter peg (fill debt order at MCOP)
 
    asset call_pays = order_receives;
    if( maker_filled ) // Regardless of hf core-2591
@@ -1349,12 +1348,11 @@ database::match_result_type database::match( const limit_order_object& bid, cons
 
    bool cull_taker = false;
 
-   auto maint_time = get_dynamic_global_properties().next_maintenance_time;
-   bool before_core_hardfork_1270 = ( maint_time <= HARDFORK_CORE_1270_TIME ); // call price caching issue
-   bool after_core_hardfork_2481 = HARDFORK_CORE_2481_PASSED( maint_time ); // Match settle orders with margin calls
+   const hardfork_state& hf = get_hardfork_state();
+   bool before_core_hardfork_1270 = !hf.core_1270_passed(); // call price caching issue
+   bool after_core_hardfork_2481 = hf.core_2481_passed(); // Match settle orders with margin calls
 
-   auto head_time = head_block_time();
-   bool after_core_hardfork_2582 = HARDFORK_CORE_2582_PASSED( head_time ); // Price feed issues
+   bool after_core_hardfork_2582 = hf.core_2582_passed(); // Price feed issues
 
    const auto& feed_price = after_core_hardfork_2582 ? bitasset.median_feed.settlement_price
                                                      : bitasset.current_feed.settlement_price;
@@ -1460,8 +1458,8 @@ asset database::match_impl( const force_settlement_object& settle,
    FC_ASSERT(call.get_debt().asset_id == settle.balance.asset_id );
    FC_ASSERT(call.debt > 0 && call.collateral > 0 && settle.balance.amount > 0);
 
-   auto maint_time = get_dynamic_global_properties().next_maintenance_time;
-   bool before_core_hardfork_342 = ( maint_time <= HARDFORK_CORE_342_TIME ); // better rounding
+   const hardfork_state& hf = get_hardfork_state();
+   bool before_core_hardfork_342 = !hf.core_342_passed(); // better rounding
 
    auto settle_for_sale = std::min(settle.balance, max_settlement);
    auto call_debt = call.get_debt();
@@ -1485,7 +1483,7 @@ asset database::match_impl( const force_settlement_object& settle,
 
    // Be here, the call order may be paying nothing.
    bool cull_settle_order = false; // whether need to cancel dust settle order
-   if( maint_time > HARDFORK_CORE_184_TIME && call_pays.amount == 0 )
+   if( hf.core_184_passed() && call_pays.amount == 0 )
    {
       if( call_receives == call_debt ) // the call order is smaller than or equal to the settle order
       {
@@ -1784,7 +1782,7 @@ optional<limit_order_id_type> database::process_limit_order_on_fill( const limit
 bool database::fill_limit_order( const limit_order_object& order, const asset& pays, const asset& receives,
                                  bool cull_if_small, const price& fill_price, const bool is_maker)
 { try {
-   if( head_block_time() < HARDFORK_555_TIME )
+   if( !get_hardfork_state().hf_555_passed() )
       cull_if_small = true;
 
    // GCOVR_EXCL_START
@@ -1936,10 +1934,10 @@ bool database::fill_call_order( const call_order_object& order, const asset& pay
          }
          else // the debt was not completely paid
          {
-            auto maint_time = get_dynamic_global_properties().next_maintenance_time;
+            const hardfork_state& hf = get_hardfork_state();
             // update call_price after core-343 hard fork,
             // but don't update call_price after core-1270 hard fork
-            if( maint_time <= HARDFORK_CORE_1270_TIME && maint_time > HARDFORK_CORE_343_TIME )
+            if( !hf.core_1270_passed() && hf.core_343_passed() )
             {
                o.call_price = price::call_price( o.get_debt(), o.get_collateral(),
                      bitasset.current_feed.maintenance_collateral_ratio );
@@ -2019,7 +2017,7 @@ bool database::fill_settle_order( const force_settlement_object& settle, const a
    // TODO Check whether the HF check can be removed after the HF.
    //      Note: even if logically it can be removed, perhaps the removal will lead to a small performance
    //            loss. Needs testing.
-   if( head_block_time() >= HARDFORK_CORE_1780_TIME )
+   if( get_hardfork_state().core_1780_passed() )
       settle_owner_ptr = &settle.owner(*this);
    // Compute and pay the market fees:
    asset market_fees = pay_market_fees( settle_owner_ptr, get(receives.asset_id), receives, is_maker );
@@ -2080,10 +2078,9 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
                                   const asset_bitasset_data_object* bitasset_ptr,
                                   bool mute_exceptions, bool skip_matching_settle_orders )
 { try {
-    const auto& dyn_prop = get_dynamic_global_properties();
-    auto maint_time = dyn_prop.next_maintenance_time;
+    const hardfork_state& hf = get_hardfork_state();
     if( for_new_limit_order )
-       FC_ASSERT( maint_time <= HARDFORK_CORE_625_TIME ); // `for_new_limit_order` is only true before HF 338 / 625
+       FC_ASSERT( !hf.core_625_passed() ); // `for_new_limit_order` is only true before HF 338 / 625
 
     if( !mia.is_market_issued() ) return false;
 
@@ -2094,7 +2091,7 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
     // if check_for_blackswan never triggered a black swan on a prediction market.
     // NOTE: check_for_blackswan returning true does not always mean a black
     // swan was triggered.
-    if ( maint_time >= HARDFORK_CORE_460_TIME && bitasset.is_prediction_market )
+    if ( hf.core_460_passed() && bitasset.is_prediction_market )
        return false;
 
     using bsrm_type = bitasset_options::black_swan_response_type;
@@ -2112,8 +2109,8 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
     const limit_order_index& limit_index = get_index_type<limit_order_index>();
     const auto& limit_price_index = limit_index.indices().get<by_price>();
 
-    bool before_core_hardfork_1270 = ( maint_time <= HARDFORK_CORE_1270_TIME ); // call price caching issue
-    bool after_core_hardfork_2481 = HARDFORK_CORE_2481_PASSED( maint_time ); // Match settle orders with margin calls
+    bool before_core_hardfork_1270 = !hf.core_1270_passed(); // call price caching issue
+    bool after_core_hardfork_2481 = hf.core_2481_passed(); // Match settle orders with margin calls
 
     // Looking for limit orders selling the most USD for the least CORE.
     auto max_price = price::max( bitasset.asset_id, bitasset.options.short_backing_asset );
@@ -2135,7 +2132,8 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
     const call_order_index& call_index = get_index_type<call_order_index>();
     const auto& call_price_index = call_index.indices().get<by_price>();
     // Note: it is safe to iterate here even if there is no call order due to individual settlements
-    const auto& call_collateral_index = call_index.indices().get<by_collateral>();
+    const auto& call_collateral_index = get_call_orders_by_collateral().get_call_orders( bitasset.asset_id,
+                                                                         bitasset.options.short_backing_asset );
 
     auto call_min = price::min( bitasset.options.short_backing_asset, bitasset.asset_id );
     auto call_max = price::max( bitasset.options.short_backing_asset, bitasset.asset_id );
@@ -2152,26 +2150,25 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
     }
     else
     {
-       call_collateral_itr = call_collateral_index.lower_bound( call_min );
-       call_collateral_end = call_collateral_index.upper_bound( call_max );
+       call_collateral_itr = call_collateral_index.begin();
+       call_collateral_end = call_collateral_index.end();
     }
 
     bool filled_limit = false;
     bool margin_called = false;         // toggles true once/if we actually execute a margin call
 
-    auto head_time = head_block_time();
     auto head_num = head_block_num();
 
-    bool before_hardfork_615 = ( head_time < HARDFORK_615_TIME );
-    bool after_hardfork_436 = ( head_time > HARDFORK_436_TIME );
+    bool before_hardfork_615 = !hf.hf_615_passed();
+    bool after_hardfork_436 = hf.hf_436_passed();
 
-    bool before_core_hardfork_342 = ( maint_time <= HARDFORK_CORE_342_TIME ); // better rounding
-    bool before_core_hardfork_343 = ( maint_time <= HARDFORK_CORE_343_TIME ); // update call_price on partial fill
-    bool before_core_hardfork_453 = ( maint_time <= HARDFORK_CORE_453_TIME ); // multiple matching issue
-    bool before_core_hardfork_606 = ( maint_time <= HARDFORK_CORE_606_TIME ); // feed always trigger call
-    bool before_core_hardfork_834 = ( maint_time <= HARDFORK_CORE_834_TIME ); // target collateral ratio option
+    bool before_core_hardfork_342 = !hf.core_342_passed(); // better rounding
+    bool before_core_hardfork_343 = !hf.core_343_passed(); // update call_price on partial fill
+    bool before_core_hardfork_453 = !hf.core_453_passed(); // multiple matching issue
+    bool before_core_hardfork_606 = !hf.core_606_passed(); // feed always trigger call
+    bool before_core_hardfork_834 = !hf.core_834_passed(); // target collateral ratio option
 
-    bool after_core_hardfork_2582 = HARDFORK_CORE_2582_PASSED( head_time ); // Price feed issues
+    bool after_core_hardfork_2582 = hf.core_2582_passed(); // Price feed issues
 
     auto has_call_order = [ before_core_hardfork_1270,
                             &call_collateral_itr,&call_collateral_end,
@@ -2194,7 +2191,7 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
 
       if( settled_some ) // which implies that BSRM is individual settlement to fund or to order
       {
-         call_collateral_itr = call_collateral_index.lower_bound( call_min );
+         call_collateral_itr = call_collateral_index.begin();
          if( call_collateral_itr == call_collateral_end ) // no call order left
          {
             check_settled_debt_order( bitasset );
@@ -2206,7 +2203,8 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
       }
 
       // be here, there exists at least one call order
-      const call_order_object& call_order = ( before_core_hardfork_1270 ? *call_price_itr : *call_collateral_itr );
+      const call_order_object& call_order = ( before_core_hardfork_1270 ? *call_price_itr
+                                                                        : *call_collateral_itr->order );
 
       // Feed protected (don't call if CR>MCR) https://github.com/cryptonomex/graphene/issues/436
       bool feed_protected = before_core_hardfork_1270 ?
@@ -2377,7 +2375,7 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
             }
 
             if( !before_core_hardfork_1270 )
-               call_collateral_itr = call_collateral_index.lower_bound( call_min );
+               call_collateral_itr = call_collateral_index.begin();
             else if( !before_core_hardfork_343 )
                call_price_itr = call_price_index.lower_bound( call_min );
 
@@ -2416,7 +2414,7 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
       if( match_force_settlements( bitasset ) )
       {
          margin_called = true;
-         call_collateral_itr = call_collateral_index.lower_bound( call_min );
+         call_collateral_itr = call_collateral_index.begin();
          if( update_current_feed )
          {
             // Note: we do not call update_bitasset_current_feed() here,
@@ -2434,28 +2432,26 @@ bool database::check_call_orders( const asset_object& mia, bool enable_black_swa
 bool database::match_force_settlements( const asset_bitasset_data_object& bitasset )
 {
    // Defensive checks
-   auto maint_time = get_dynamic_global_properties().next_maintenance_time;
+   const hardfork_state& hf = get_hardfork_state();
    // GCOVR_EXCL_START
    // Defensive code, normally none of these should fail
-   FC_ASSERT( HARDFORK_CORE_2481_PASSED( maint_time ), "Internal error: hard fork core-2481 not passed" );
+   FC_ASSERT( hf.core_2481_passed(), "Internal error: hard fork core-2481 not passed" );
    FC_ASSERT( !bitasset.is_prediction_market, "Internal error: asset is a prediction market" );
    FC_ASSERT( !bitasset.is_globally_settled(), "Internal error: asset is globally settled already" );
    FC_ASSERT( !bitasset.current_feed.settlement_price.is_null(), "Internal error: no sufficient price feeds" );
    // GCOVR_EXCL_STOP
 
-   auto head_time = head_block_time();
-   bool after_core_hardfork_2582 = HARDFORK_CORE_2582_PASSED( head_time ); // Price feed issues
+   bool after_core_hardfork_2582 = hf.core_2582_passed(); // Price feed issues
 
    const auto& settlement_index = get_index_type<force_settlement_index>().indices().get<by_expiration>();
    auto settle_itr = settlement_index.lower_bound( bitasset.asset_id );
    auto settle_end = settlement_index.upper_bound( bitasset.asset_id );
 
    // Note: it is safe to iterate here even if there is no call order due to individual settlements
-   const auto& call_collateral_index = get_index_type<call_order_index>().indices().get<by_collateral>();
-   auto call_min = price::min( bitasset.options.short_backing_asset, bitasset.asset_id );
-   auto call_max = price::max( bitasset.options.short_backing_asset, bitasset.asset_id );
-   auto call_itr = call_collateral_index.lower_bound( call_min );
-   auto call_end = call_collateral_index.upper_bound( call_max );
+   const auto& call_collateral_index = get_call_orders_by_collateral().get_call_orders( bitasset.asset_id,
+                                                                        bitasset.options.short_backing_asset );
+   auto call_itr = call_collateral_index.begin();
+   auto call_end = call_collateral_index.end();
 
    // Price at which margin calls sit on the books.
    // It is the MCOP, which may deviate from MSSP due to MCFR.
@@ -2469,7 +2465,7 @@ bool database::match_force_settlements( const asset_bitasset_data_object& bitass
    while( settle_itr != settle_end && call_itr != call_end )
    {
       const force_settlement_object& settle_order = *settle_itr;
-      const call_order_object& call_order = *call_itr;
+      const call_order_object& call_order = *call_itr->order;
 
       // Feed protected (don't call if CR>MCR) https://github.com/cryptonomex/graphene/issues/436
       if( bitasset.current_maintenance_collateralization < call_order.collateralization() )
@@ -2496,15 +2492,15 @@ bool database::match_force_settlements( const asset_bitasset_data_object& bitass
       // else : result.amount == 0, it means the settle order got canceled directly and the call order did not change
 
       settle_itr = settlement_index.lower_bound( bitasset.asset_id );
-      call_itr = call_collateral_index.lower_bound( call_min );
+      call_itr = call_collateral_index.begin();
    }
    return false;
 }
 
 void database::check_settled_debt_order( const asset_bitasset_data_object& bitasset )
 {
-   const auto& head_time = head_block_time();
-   bool after_core_hardfork_2591 = HARDFORK_CORE_2591_PASSED( head_time ); // Tighter peg (fill debt order at MCOP)
+   const hardfork_state& hf = get_hardfork_state();
+   bool after_core_hardfork_2591 = hf.core_2591_passed(); // Tighter peg (fill debt order at MCOP)
    if( !after_core_hardfork_2591 )
       return;
 
@@ -2639,7 +2635,7 @@ asset database::pay_market_fees(const account_object* seller, const asset_object
             {
                reward = recv_asset.amount(reward_value);
                // TODO after hf_1774, remove the `if` check, keep the code in `else`
-               if( head_block_time() < HARDFORK_1774_TIME ){
+               if( !get_hardfork_state().hf_1774_passed() ){
                   FC_ASSERT( reward < issuer_fees, "Market reward should be less than issuer fees");
                }
                else{
@@ -2652,7 +2648,7 @@ asset database::pay_market_fees(const account_object* seller, const asset_object
                auto referrer = seller->referrer;
 
                // After HF core-1800, for funds going to temp-account, redirect to committee-account
-               if( head_block_time() >= HARDFORK_CORE_1800_TIME )
+               if( get_hardfork_state().core_1800_passed() )
                {
                   if( registrar == GRAPHENE_TEMP_ACCOUNT )
                      registrar = GRAPHENE_COMMITTEE_ACCOUNT;
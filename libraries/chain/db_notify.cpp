@@ -24,6 +24,8 @@
 #include <graphene/chain/impacted.hpp>
 #include <graphene/chain/hardfork.hpp>
 
+#include <fc/thread/parallel.hpp>
+
 using namespace fc;
 namespace graphene { namespace chain { namespace detail {
 
@@ -538,8 +540,7 @@ static void get_relevant_accounts( const object* obj, flat_set<account_id_type>&
               break;
            } case impl_transaction_history_object_type:{
               const auto* aobj = dynamic_cast<const transaction_history_object*>(obj);
-              transaction_get_impacted_accs( aobj->trx, accounts,
-                                             ignore_custom_op_required_auths );
+              accounts.insert( aobj->impacted_accounts.begin(), aobj->impacted_accounts.end() );
               break;
            } case impl_blinded_balance_object_type:{
               const auto* aobj = dynamic_cast<const blinded_balance_object*>(obj);
@@ -579,11 +580,90 @@ static void get_relevant_accounts( const object* obj, flat_set<account_id_type>&
    }
 } // end get_relevant_accounts( const object* obj, flat_set<account_id_type>& accounts )
 
+/// Wait for the task of a read-only block observer, logging anything it throws
+static void wait_for_read_only_block_observer( fc::future<void>& notification )
+{
+   try
+   {
+      notification.wait();
+   }
+   catch( const fc::exception& e )
+   {
+      elog( "Caught exception in read-only block observer: ${e}", ("e", e.to_detail_string() ) );
+   }
+   catch( const std::exception& e )
+   {
+      elog( "Caught exception in read-only block observer: ${e}", ("e", e.what() ) );
+   }
+   catch( ... )
+   {
+      elog( "Caught unknown exception in read-only block observer" );
+   }
+}
+
 void database::notify_applied_block( const signed_block& block )
 {
    GRAPHENE_TRY_NOTIFY( applied_block, block )
 }
 
+void database::add_read_only_block_observer( read_only_block_observer observer )
+{
+   _read_only_block_observers.emplace_back( std::move( observer ) );
+}
+
+void database::notify_read_only_block_observers( const signed_block& block )
+{
+   if( _read_only_block_observers.empty() )
+      return;
+
+   auto record = std::make_shared<applied_block_record>();
+   record->block = block;
+   record->operation_results = std::move( _applied_trx_results );
+   _applied_trx_results.clear();
+   record->applied_operations = std::move( _applied_ops );
+   _applied_ops.clear();
+
+   if( _undo_db.enabled() )
+   {
+      const auto& head_undo = _undo_db.head();
+      record->new_object_ids.reserve( head_undo.new_ids.size() );
+      record->new_object_ids.insert( record->new_object_ids.end(),
+                                     head_undo.new_ids.begin(), head_undo.new_ids.end() );
+      record->changed_object_ids.reserve( head_undo.old_values.size() );
+      for( const auto& item : head_undo.old_values )
+         record->changed_object_ids.push_back( item.first );
+      record->removed_object_ids.reserve( head_undo.removed.size() );
+      for( const auto& item : head_undo.removed )
+         record->removed_object_ids.push_back( item.first );
+   }
+
+   std::shared_ptr<const applied_block_record> shared_record = std::move( record );
+   // The blocks applied by one push_block() call, e.g. when switching forks, are not waited for in between, so the
+   // task of each observer waits for its task of the previous block
+   _read_only_block_notifications.resize( _read_only_block_observers.size() );
+   for( size_t i = 0; i < _read_only_block_observers.size(); ++i )
+   {
+      const read_only_block_observer& observer = _read_only_block_observers[i];
+      fc::future<void> previous = std::move( _read_only_block_notifications[i] );
+      _read_only_block_notifications[i] = fc::do_parallel( [observer,shared_record,previous] () mutable {
+         if( previous.valid() )
+            wait_for_read_only_block_observer( previous );
+         observer( *shared_record );
+      } );
+   }
+}
+
+void database::wait_for_read_only_block_observers()
+{
+   // Wait in registration order so that the observers finish one block before they see the next one
+   for( auto& notification : _read_only_block_notifications )
+   {
+      if( notification.valid() )
+         wait_for_read_only_block_observer( notification );
+   }
+   _read_only_block_notifications.clear();
+}
+
 void database::notify_on_pending_transaction( const signed_transaction& tx )
 {
    GRAPHENE_TRY_NOTIFY( on_pending_transaction, tx )
@@ -37,6 +37,7 @@
 
 namespace graphene { namespace chain {
 database& generic_evaluator::db()const { return trx_state->db(); }
+apply_profiler* generic_evaluator::get_apply_profiler()const { return db().get_apply_profiler(); }
 
    operation_result generic_evaluator::start_evaluate( transaction_evaluation_state& eval_state, const operation& op, bool apply )
    { try {
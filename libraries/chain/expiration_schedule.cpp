@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/chain/expiration_schedule.hpp>
+
+namespace graphene { namespace chain {
+
+void expiration_schedule::deadline_set::add( fc::time_point_sec deadline )
+{
+   ++_deadlines[ deadline ];
+   ++_size;
+}
+
+void expiration_schedule::deadline_set::remove( fc::time_point_sec deadline )
+{
+   auto itr = _deadlines.find( deadline );
+   if( itr == _deadlines.end() )
+      return;
+   if( 0 == --itr->second )
+      _deadlines.erase( itr );
+   --_size;
+}
+
+void expiration_schedule::clear()
+{
+   for( deadline_set& deadlines : _deadline_sets )
+      deadlines.clear();
+}
+
+bool expiration_schedule::any_due( fc::time_point_sec now )const
+{
+   for( const deadline_set& deadlines : _deadline_sets )
+   {
+      if( deadlines.is_due( now ) )
+         return true;
+   }
+   return false;
+}
+
+size_t expiration_schedule::size()const
+{
+   size_t result = 0;
+   for( const deadline_set& deadlines : _deadline_sets )
+      result += deadlines.size();
+   return result;
+}
+
+} } // graphene::chain
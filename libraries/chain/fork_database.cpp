@@ -22,9 +22,23 @@
  * THE SOFTWARE.
  */
 #include <graphene/chain/fork_database.hpp>
+#include <graphene/chain/config.hpp>
 #include <graphene/chain/exceptions.hpp>
 
+#include <unordered_map>
+
 namespace graphene { namespace chain {
+
+/// @return the number of the ancestor which the skip pointer of a block with number @p num points to
+static uint32_t skip_num( uint32_t num )
+{
+   // Clearing the lowest set bits makes the skip pointers of blocks form a skip list over their ancestors
+   const auto clear_lowest_bit = []( uint32_t n ) { return n & ( n - 1 ); };
+   if( num < 2 )
+      return 0;
+   return ( num & 1 ) ? clear_lowest_bit( clear_lowest_bit( num - 1 ) ) + 1 : clear_lowest_bit( num );
+}
+
 fork_database::fork_database()
 {
 }
@@ -32,6 +46,7 @@ void fork_database::reset()
 {
    _head.reset();
    _index.clear();
+   _memory_usage = 0;
 }
 
 void fork_database::pop_block()
@@ -45,7 +60,9 @@ void fork_database::pop_block()
 void     fork_database::start_block(signed_block b)
 {
    auto item = std::make_shared<fork_item>(std::move(b));
+   item->memory_size = sizeof(fork_item) + fc::raw::pack_size( item->data );
    _index.insert(item);
+   _memory_usage += item->memory_size;
    _head = item;
 }
 
@@ -61,6 +78,7 @@ shared_ptr<fork_item>  fork_database::push_block(const signed_block& b)
    }
    catch ( const unlinkable_block_exception& e )
    {
+      ++_unlinkable_blocks;
       wlog( "Pushing block to fork database that failed to link: ${id}, ${num}", ("id",b.id())("num",b.block_num()) );
       wlog( "Head: ${num}, ${id}", ("num",_head->data.block_num())("id",_head->data.id()) );
       throw;
@@ -83,9 +101,12 @@ void  fork_database::_push_block(const item_ptr& item)
       auto itr = index.find(item->previous_id());
       GRAPHENE_ASSERT(itr != index.end(), unlinkable_block_exception, "block does not link to known chain");
       item->prev = *itr;
+      item->skip = fetch_ancestor( *itr, skip_num( item->num ) );
    }
 
-   _index.insert(item);
+   item->memory_size = sizeof(fork_item) + fc::raw::pack_size( item->data );
+   if( _index.insert(item).second )
+      _memory_usage += item->memory_size;
    if( !_head ) _head = item;
    else if( item->num > _head->num )
    {
@@ -93,10 +114,80 @@ void  fork_database::_push_block(const item_ptr& item)
       uint32_t min_num = _head->num - std::min( _max_size, _head->num );
       auto& num_idx = _index.get<block_num>();
       while( !num_idx.empty() && (*num_idx.begin())->num < min_num )
-         num_idx.erase( num_idx.begin() );
+         _erase( num_idx, num_idx.begin() );
+   }
+   _enforce_memory_limit( item );
+}
+
+template<typename Index, typename Iterator>
+void fork_database::_erase( Index& index, Iterator itr )
+{
+   _memory_usage -= (*itr)->memory_size;
+   index.erase( itr );
+}
+
+void fork_database::set_max_memory( uint64_t bytes )
+{
+   _max_memory = bytes;
+   _enforce_memory_limit();
+}
+
+void fork_database::_enforce_memory_limit( const item_ptr& pushed )
+{
+   if( 0 == _max_memory || _memory_usage <= _max_memory || !_head )
+      return;
+
+   // Branches whose last block is within the undo window of the head block might still become the longest one
+   const uint32_t min_protected_num = _head->num - std::min<uint32_t>( _head->num, GRAPHENE_MIN_UNDO_HISTORY ) + 1;
+
+   // Branches end with the blocks which no other block builds on
+   std::unordered_map<block_id_type, uint32_t, std::hash<fc::ripemd160>> child_count;
+   for( const item_ptr& item : _index )
+      ++child_count[item->previous_id()];
+   vector<item_ptr> stale_tips;
+   for( const item_ptr& item : _index.get<block_num>() )
+   {
+      if( item->num >= min_protected_num )
+         break;
+      if( item != pushed && child_count.find( item->id ) == child_count.end()
+            && fetch_ancestor( _head, item->num ) != item )
+         stale_tips.push_back( item );
+   }
+
+   // Drop the oldest branches first, each one back to the block where it forks off a branch which is kept
+   auto& id_idx = _index.get<block_id>();
+   for( const item_ptr& tip : stale_tips )
+   {
+      if( _memory_usage <= _max_memory )
+         break;
+      item_ptr item = tip;
+      while( item && fetch_ancestor( _head, item->num ) != item )
+      {
+         item_ptr prev = item->prev.lock();
+         auto itr = id_idx.find( item->id );
+         if( itr == id_idx.end() )
+            break;
+         ++_pruned_items;
+         _erase( id_idx, itr );
+         auto count_itr = child_count.find( item->previous_id() );
+         if( count_itr == child_count.end() || --count_itr->second > 0 )
+            break;
+         item = prev;
+      }
    }
 }
 
+fork_database_metrics fork_database::get_metrics()const
+{
+   fork_database_metrics metrics;
+   metrics.items = static_cast<uint32_t>( _index.size() );
+   metrics.memory_usage = _memory_usage;
+   metrics.max_memory = _max_memory;
+   metrics.pruned_items = _pruned_items;
+   metrics.unlinkable_blocks = _unlinkable_blocks;
+   return metrics;
+}
+
 void fork_database::set_max_size( uint32_t s )
 {
    _max_size = s;
@@ -107,7 +198,7 @@ void fork_database::set_max_size( uint32_t s )
    while( itr != by_num_idx.end() )
    {
       if( (*itr)->num < std::max(int64_t(0),int64_t(_head->num) - _max_size) )
-         by_num_idx.erase(itr);
+         _erase( by_num_idx, itr );
       else
          break;
       itr = by_num_idx.begin();
@@ -189,6 +280,50 @@ pair<fork_database::branch_type,fork_database::branch_type>
    return result;
 } FC_CAPTURE_AND_RETHROW( (first)(second) ) }
 
+item_ptr fork_database::fetch_ancestor( item_ptr item, uint32_t num )
+{
+   while( item && item->num > num )
+   {
+      item_ptr skip = ( skip_num( item->num ) >= num ) ? item->skip.lock() : item_ptr();
+      item = skip ? skip : item->prev.lock();
+   }
+   return ( item && item->num == num ) ? item : item_ptr();
+}
+
+item_ptr fork_database::fetch_common_ancestor( const block_id_type& first, const block_id_type& second )const
+{ try {
+   item_ptr first_item = fetch_block( first );
+   FC_ASSERT( first_item );
+   item_ptr second_item = fetch_block( second );
+   FC_ASSERT( second_item );
+
+   if( first_item->num > second_item->num )
+      first_item = fetch_ancestor( first_item, second_item->num );
+   else
+      second_item = fetch_ancestor( second_item, first_item->num );
+   FC_ASSERT( first_item && second_item );
+
+   while( first_item != second_item )
+   {
+      // Blocks with the same number have skip pointers to the same number. If those ancestors differ, the common
+      // ancestor is further back.
+      item_ptr first_skip = first_item->skip.lock();
+      item_ptr second_skip = second_item->skip.lock();
+      if( first_skip && second_skip && first_skip != second_skip )
+      {
+         first_item = first_skip;
+         second_item = second_skip;
+      }
+      else
+      {
+         first_item = first_item->prev.lock();
+         second_item = second_item->prev.lock();
+         FC_ASSERT( first_item && second_item );
+      }
+   }
+   return first_item;
+} FC_CAPTURE_AND_RETHROW( (first)(second) ) }
+
 void fork_database::set_head(shared_ptr<fork_item> h)
 {
    _head = h;
@@ -196,7 +331,10 @@ void fork_database::set_head(shared_ptr<fork_item> h)
 
 void fork_database::remove(block_id_type id)
 {
-   _index.get<block_id>().erase(id);
+   auto& id_idx = _index.get<block_id>();
+   auto itr = id_idx.find(id);
+   if( itr != id_idx.end() )
+      _erase( id_idx, itr );
    // If we're removing head, try to pop it
    if( _head && _head->id == id )
    {
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/chain/hardfork_state.hpp>
+#include <graphene/chain/global_property_object.hpp>
+#include <graphene/chain/hardfork.hpp>
+
+namespace graphene { namespace chain {
+
+hardfork_state::hardfork_state( fc::time_point_sec head_time, fc::time_point_sec maint_time )
+{
+   _passed[core_184]  = ( maint_time > HARDFORK_CORE_184_TIME );
+   _passed[core_338]  = ( maint_time > HARDFORK_CORE_338_TIME );
+   _passed[core_342]  = ( maint_time > HARDFORK_CORE_342_TIME );
+   _passed[core_343]  = ( maint_time > HARDFORK_CORE_343_TIME );
+   _passed[core_453]  = ( maint_time > HARDFORK_CORE_453_TIME );
+   _passed[core_460]  = ( maint_time >= HARDFORK_CORE_460_TIME );
+   _passed[core_606]  = ( maint_time > HARDFORK_CORE_606_TIME );
+   _passed[core_625]  = ( maint_time > HARDFORK_CORE_625_TIME );
+   _passed[core_834]  = ( maint_time > HARDFORK_CORE_834_TIME );
+   _passed[core_1270] = ( maint_time > HARDFORK_CORE_1270_TIME );
+   _passed[core_1669] = ( maint_time > HARDFORK_CORE_1669_TIME );
+   _passed[core_2481] = HARDFORK_CORE_2481_PASSED( maint_time );
+
+   _passed[hf_436]    = ( head_time > HARDFORK_436_TIME );
+   _passed[hf_555]    = ( head_time >= HARDFORK_555_TIME );
+   _passed[hf_615]    = ( head_time >= HARDFORK_615_TIME );
+   _passed[hf_1774]   = ( head_time >= HARDFORK_1774_TIME );
+   _passed[core_1780] = ( head_time >= HARDFORK_CORE_1780_TIME );
+   _passed[core_1800] = ( head_time >= HARDFORK_CORE_1800_TIME );
+   _passed[core_2582] = HARDFORK_CORE_2582_PASSED( head_time );
+   _passed[core_2591] = HARDFORK_CORE_2591_PASSED( head_time );
+}
+
+void hardfork_state_index::update( const graphene::db::object& obj )
+{
+   assert( dynamic_cast<const dynamic_global_property_object*>(&obj) ); // for debug only
+   const auto& dgp = static_cast<const dynamic_global_property_object&>(obj);
+   _state = hardfork_state( dgp.time, dgp.next_maintenance_time );
+}
+
+} } // graphene::chain
@@ -29,6 +29,8 @@
 
 #include <boost/multi_index/composite_key.hpp>
 
+#include <deque>
+
 namespace graphene { namespace chain {
    class database;
    class account_object;
@@ -323,6 +325,49 @@ namespace graphene { namespace chain {
          }
    };
 
+   /**
+    *  @brief This secondary index counts changes of owner and active authorities of accounts, so that caches of
+    *  authority checks can tell when they are outdated.
+    */
+   class account_authority_version_index : public secondary_index
+   {
+      public:
+         virtual void object_inserted( const object& obj ) override {}
+         virtual void object_removed( const object& obj ) override;
+         virtual void about_to_modify( const object& before ) override;
+         virtual void object_modified( const object& after  ) override;
+
+         /// @return a number which changes whenever the owner or active authority of an account changes
+         uint64_t get_version()const { return _version; }
+
+         /**
+          *  Calls @p f with each account whose authorities have changed since @p version, accounts may repeat
+          *  @return false if the changes are too old to be known, then all accounts must be considered changed
+          */
+         template< typename Function >
+         bool for_each_change_since( uint64_t version, Function&& f )const
+         {
+            if( _version - version > _recent_changes.size() )
+               return false;
+            for( auto itr = _recent_changes.end() - static_cast<std::ptrdiff_t>( _version - version );
+                 itr != _recent_changes.end(); ++itr )
+               f( *itr );
+            return true;
+         }
+
+      private:
+         void record_change( account_id_type id );
+
+         /// The maximum number of changes kept in @ref _recent_changes
+         static constexpr size_t max_recent_changes = 1024;
+
+         uint64_t   _version = 0;
+         /// The accounts of the latest changes, the last one is the change to the current version
+         std::deque<account_id_type> _recent_changes;
+         authority  _before_owner;
+         authority  _before_active;
+   };
+
    /**
     *  @brief This secondary index will allow a reverse lookup of all accounts that a particular key or account
     *  is an potential signing authority.
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/chain/operation_history_object.hpp>
+
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  @brief The real and virtual operations applied in the current block, in the order they were applied
+    *
+    *  Entries live in fixed-size chunks which are kept when the log is cleared, so that the log of a block reuses
+    *  the memory of the previous blocks and no entry is moved or copied while the log grows. An entry is referenced
+    *  by its index, which stays valid until the log is truncated below it or cleared. Entries of failed operations
+    *  can be reset to keep the indexes of the following ones.
+    */
+   class applied_operation_log
+   {
+      public:
+         using value_type = optional<operation_history_object>;
+
+         class const_iterator
+         {
+            public:
+               using iterator_category = std::forward_iterator_tag;
+               using value_type        = applied_operation_log::value_type;
+               using difference_type   = std::ptrdiff_t;
+               using pointer           = const value_type*;
+               using reference         = const value_type&;
+
+               const_iterator( const applied_operation_log& log, size_t index ) : _log( &log ), _index( index ) {}
+
+               reference operator*()const { return (*_log)[_index]; }
+               pointer operator->()const { return &(*_log)[_index]; }
+               const_iterator& operator++() { ++_index; return *this; }
+               const_iterator operator++(int) { const_iterator result( *this ); ++_index; return result; }
+               bool operator==( const const_iterator& other )const { return _index == other._index; }
+               bool operator!=( const const_iterator& other )const { return _index != other._index; }
+
+            private:
+               const applied_operation_log* _log;
+               size_t                       _index;
+         };
+
+         applied_operation_log() = default;
+         applied_operation_log( applied_operation_log&& other ) noexcept;
+         applied_operation_log& operator=( applied_operation_log&& other ) noexcept;
+
+         /// Append an entry for @p op and return it for the caller to fill in, its index is size() - 1
+         operation_history_object& append( const operation& op );
+
+         /// Reset the entries from @p new_size on and drop them from the log
+         void truncate( size_t new_size );
+         void clear() { truncate( 0 ); }
+
+         size_t size()const { return _size; }
+         bool empty()const { return 0 == _size; }
+         /// @return the number of entries the log can hold without allocating
+         size_t capacity()const { return _chunks.size() * chunk_size; }
+
+         const value_type& operator[]( size_t index )const { return _chunks[index / chunk_size][index % chunk_size]; }
+         value_type& operator[]( size_t index ) { return _chunks[index / chunk_size][index % chunk_size]; }
+
+         const_iterator begin()const { return const_iterator( *this, 0 ); }
+         const_iterator end()const { return const_iterator( *this, _size ); }
+
+      private:
+         static constexpr size_t chunk_size = 128;
+
+         std::vector< std::unique_ptr<value_type[]> > _chunks;
+         size_t                                         _size = 0;
+   };
+
+} } // graphene::chain
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <fc/filesystem.hpp>
+#include <fc/reflect/reflect.hpp>
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace graphene { namespace chain {
+
+   /**
+    * A latency histogram with logarithmic buckets, bucket N counts samples which took
+    * [2^N, 2^(N+1)) nanoseconds (bucket 0 also counts samples below 1 ns).
+    */
+   struct latency_histogram
+   {
+      static constexpr size_t bucket_count = 32;
+
+      uint64_t              count    = 0;
+      uint64_t              total_ns = 0;
+      uint64_t              max_ns   = 0;
+      std::vector<uint64_t> buckets  = std::vector<uint64_t>( bucket_count );
+
+      void record( uint64_t ns );
+   };
+
+   struct operation_latency_stats
+   {
+      std::string       operation;
+      /// Time spent in database::apply_operation(), including nested operations e.g. of proposals
+      latency_histogram total;
+      /// Time spent in fee handling: prepare_fee(), fee schedule check, convert_fee() and pay_fee()
+      latency_histogram fee;
+      /// Time spent in do_evaluate()
+      latency_histogram evaluate;
+      /// Time spent in do_apply(), including the final balance adjustment of the fee payer
+      latency_histogram apply;
+   };
+
+   struct block_step_latency_stats
+   {
+      std::string       step;
+      latency_histogram histogram;
+   };
+
+   struct apply_profile
+   {
+      std::vector<operation_latency_stats>  operations;
+      std::vector<block_step_latency_stats> block_steps;
+   };
+
+   /**
+    * Collects latency histograms of operations, evaluator phases and block processing steps.
+    *
+    * The profiler is owned by the database and only exists when it is enabled, so that a node which does not
+    * use it pays nothing but a null pointer check. All recording is done in the thread applying blocks.
+    */
+   class apply_profiler
+   {
+   public:
+      enum class evaluator_phase
+      {
+         fee,
+         evaluate,
+         apply,
+         PHASE_COUNT
+      };
+
+      enum class block_step
+      {
+         apply_transactions,
+         update_global_dynamic_data,
+         process_tickets,
+         perform_chain_maintenance,
+         create_block_summary,
+         clear_expired_transactions,
+         clear_expired_proposals,
+         clear_expired_orders,
+         clear_expired_force_settlements,
+         clear_expired_htlcs,
+         update_expired_feeds,
+         update_core_exchange_rates,
+         update_withdraw_permissions,
+         update_credit_offers_and_deals,
+         update_witness_schedule,
+         notify_applied_block,
+         notify_changed_objects,
+         STEP_COUNT
+      };
+
+      using clock = std::chrono::steady_clock;
+
+      apply_profiler();
+
+      void record_operation( int which, uint64_t ns );
+      void record_phase( int which, evaluator_phase phase, uint64_t ns );
+      void record_block_step( block_step step, uint64_t ns );
+
+      /// Returns the collected statistics, operations and steps which have never been recorded are omitted
+      apply_profile get_profile()const;
+      void reset();
+      /// Writes the collected statistics to @p file as JSON
+      void save_profile( const fc::path& file )const;
+
+      static uint64_t elapsed_ns( clock::time_point since, clock::time_point until )
+      {
+         return uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( until - since ).count() );
+      }
+
+      /**
+       * Measures consecutive sections of code, each call to lap() records the time elapsed since construction
+       * or the previous lap. Does nothing if the profiler is null.
+       */
+      class lap_timer
+      {
+      public:
+         explicit lap_timer( apply_profiler* profiler )
+         : _profiler( profiler ), _last( profiler ? clock::now() : clock::time_point() ) {}
+
+         void lap( block_step step )
+         {
+            if( _profiler )
+               _profiler->record_block_step( step, next() );
+         }
+         void lap( int which )
+         {
+            if( _profiler )
+               _profiler->record_operation( which, next() );
+         }
+         void lap( int which, evaluator_phase phase )
+         {
+            if( _profiler )
+               _profiler->record_phase( which, phase, next() );
+         }
+         /// Restart measuring from now, e.g. to exclude a section of code
+         void skip()
+         {
+            if( _profiler )
+               _last = clock::now();
+         }
+
+      private:
+         uint64_t next()
+         {
+            auto now = clock::now();
+            uint64_t ns = elapsed_ns( _last, now );
+            _last = now;
+            return ns;
+         }
+
+         apply_profiler*   _profiler;
+         clock::time_point _last;
+      };
+
+   private:
+      struct operation_histograms
+      {
+         latency_histogram total;
+         std::array<latency_histogram, size_t(evaluator_phase::PHASE_COUNT)> phases;
+      };
+
+      std::vector<operation_histograms> _operations;
+      std::array<latency_histogram, size_t(block_step::STEP_COUNT)> _block_steps;
+   };
+
+} } // graphene::chain
+
+FC_REFLECT( graphene::chain::latency_histogram, (count)(total_ns)(max_ns)(buckets) )
+FC_REFLECT( graphene::chain::operation_latency_stats, (operation)(total)(fee)(evaluate)(apply) )
+FC_REFLECT( graphene::chain::block_step_latency_stats, (step)(histogram) )
+FC_REFLECT( graphene::chain::apply_profile, (operations)(block_steps) )
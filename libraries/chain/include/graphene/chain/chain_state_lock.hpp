@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <fc/thread/future.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace graphene { namespace chain {
+
+   /**
+    * @brief A reader-writer lock guarding the chain state against API calls running on worker threads
+    *
+    * The chain thread takes the exclusive lock around every modification of the chain state (pushing and popping
+    * blocks and transactions), and may take it recursively. Read-only API calls running on worker threads take the
+    * shared lock, so they always see the state between two modifications. Waiting writers take precedence over new
+    * readers, so block processing is delayed by at most the read-only calls that are already running.
+    *
+    * The lock is held by fc tasks, not by threads, so other tasks on the thread of a holder have to wait for it.
+    * Waiting only blocks the waiting task, the other tasks of its thread keep running.
+    */
+   class chain_state_lock
+   {
+      public:
+         void lock_shared();
+         void unlock_shared();
+
+         void lock_exclusive();
+         void unlock_exclusive();
+
+         /// @return true if the calling task holds the exclusive lock
+         bool is_writing_task()const;
+         /// @return true if the calling task holds the shared lock
+         static bool is_reading_task();
+
+         class read_guard
+         {
+            public:
+               explicit read_guard( chain_state_lock& l ) : _lock(l) { _lock.lock_shared(); }
+               ~read_guard() { _lock.unlock_shared(); }
+               read_guard( const read_guard& ) = delete;
+               read_guard& operator=( const read_guard& ) = delete;
+            private:
+               chain_state_lock& _lock;
+         };
+
+         class write_guard
+         {
+            public:
+               explicit write_guard( chain_state_lock& l ) : _lock(l) { _lock.lock_exclusive(); }
+               ~write_guard() { _lock.unlock_exclusive(); }
+               write_guard( const write_guard& ) = delete;
+               write_guard& operator=( const write_guard& ) = delete;
+            private:
+               chain_state_lock& _lock;
+         };
+
+      private:
+         struct waiting_writer
+         {
+            const void*             task;
+            fc::promise<void>::ptr  wake_up;
+         };
+
+         /// Hand the lock over to the waiters which may take it now, must be called with @ref _mutex held
+         void hand_over( std::vector<fc::promise<void>::ptr>& to_wake );
+         /// Wait until the lock is handed over to the calling task, or give it up if waiting fails
+         void wait_for_hand_over( const fc::promise<void>::ptr& wake_up, bool exclusive );
+         void release_shared();
+
+         /// Only held while the state below is updated, never while waiting for the lock
+         mutable std::mutex                   _mutex;
+         std::deque<fc::promise<void>::ptr>   _waiting_readers;
+         std::deque<waiting_writer>           _waiting_writers;
+         uint32_t                             _active_readers = 0;
+         /// Recursion depth of the exclusive lock, 0 if not locked
+         uint32_t                             _write_depth = 0;
+         /// Identifies the task which holds the exclusive lock
+         const void*                          _writer = nullptr;
+   };
+
+} }
@@ -23,6 +23,7 @@
  */
 #pragma once
 
+#include <graphene/protocol/authority_check_cache.hpp>
 #include <graphene/protocol/fee_schedule.hpp>
 
 #include <graphene/chain/global_property_object.hpp>
@@ -30,17 +31,25 @@
 #include <graphene/chain/account_object.hpp>
 #include <graphene/chain/asset_object.hpp>
 #include <graphene/chain/fork_database.hpp>
+#include <graphene/chain/recent_transaction_cache.hpp>
+#include <graphene/chain/expiration_schedule.hpp>
+#include <graphene/chain/hardfork_state.hpp>
+#include <graphene/chain/applied_operation_log.hpp>
 #include <graphene/chain/block_database.hpp>
 #include <graphene/chain/genesis_state.hpp>
 #include <graphene/chain/evaluator.hpp>
+#include <graphene/chain/chain_state_lock.hpp>
+#include <graphene/chain/operation_history_object.hpp>
 
 #include <graphene/db/object_database.hpp>
 #include <graphene/db/object.hpp>
 #include <graphene/db/simple_index.hpp>
 #include <fc/signals.hpp>
+#include <fc/thread/thread.hpp>
 
 #include <fc/log/logger.hpp>
 
+#include <atomic>
 #include <map>
 
 namespace graphene { namespace protocol { struct predicate_result; } }
@@ -51,6 +60,7 @@ namespace graphene { namespace chain {
    class op_evaluator;
    class transaction_evaluation_state;
    class proposal_object;
+   class proposal_authorization_index;
    class operation_history_object;
    class chain_property_object;
    class witness_schedule_object;
@@ -59,10 +69,33 @@ namespace graphene { namespace chain {
    class limit_order_object;
    class collateral_bid_object;
    class call_order_object;
+   class call_order_collateral_index;
 
    struct budget_record;
    enum class vesting_balance_type;
 
+   /**
+    *  @brief An immutable record of what a block did to the chain state
+    *
+    *  It is built once after a block has been applied and is handed to read-only block observers, which process it
+    *  on worker threads while the chain thread moves on. Observers must not access the database.
+    */
+   struct applied_block_record
+   {
+      /// The block as it was received or generated, see @ref operation_results for the results of its operations
+      signed_block                                   block;
+      /// Results of the operations of each transaction of the block, in the order of the transactions
+      vector< vector<operation_result> >             operation_results;
+      /// Real and virtual operations in the order they were applied
+      applied_operation_log                          applied_operations;
+      /// IDs of objects created, modified and removed by the block, empty if undo history is disabled
+      ///@{
+      vector<object_id_type>                         new_object_ids;
+      vector<object_id_type>                         changed_object_ids;
+      vector<object_id_type>                         removed_object_ids;
+      ///@}
+   };
+
    /**
     *   @class database
     *   @brief tracks the blockchain state in an extensible manner
@@ -564,7 +597,11 @@ namespace graphene { namespace chain {
          block_id_type              get_block_id_for_num( uint32_t block_num )const;
          optional<signed_block>     fetch_block_by_id( const block_id_type& id )const;
          optional<signed_block>     fetch_block_by_number( uint32_t num )const;
-         const signed_transaction&  get_recent_transaction( const transaction_id_type& trx_id )const;
+         /// Returns the block packed with fc::raw, read from the block database without unpacking if possible
+         optional<vector<char>>     fetch_raw_block_by_number( uint32_t num )const;
+         signed_transaction         get_recent_transaction( const transaction_id_type& trx_id )const;
+         /// Limit the size of the packed transactions kept for @ref get_recent_transaction
+         void                       set_recent_transaction_cache_size( uint64_t max_size );
          std::vector<block_id_type> get_block_ids_on_fork(block_id_type head_of_fork) const;
 
          void                       add_checkpoints( const flat_map<uint32_t,block_id_type>& checkpts );
@@ -587,12 +624,25 @@ namespace graphene { namespace chain {
             const fc::ecc::private_key& block_signing_private_key,
             uint32_t skip
             );
+         /**
+          *  Enable or disable reusing the state built while generating a block for pushing that block, i.e. not
+          *  applying the transactions of self-produced blocks twice. Enabled by default.
+          */
+         void enable_generated_block_state_reuse( bool enable ) { _reuse_generated_block_state = enable; }
       private:
          signed_block _generate_block(
             const fc::time_point_sec when,
             witness_id_type witness_id,
             const fc::ecc::private_key& block_signing_private_key
             );
+         /// Whether the state built by _generate_block() can be taken over for the generated block
+         bool can_reuse_generated_block_state()const;
+         /// Push a generated block whose transactions have been applied in @p block_session
+         void _push_generated_block( const signed_block& new_block,
+                                     vector< vector<operation_result> >&& trx_results,
+                                     undo_database::session block_session,
+                                     bool maint_needed,
+                                     apply_profiler::lap_timer& timer );
 
       public:
          void pop_block();
@@ -611,7 +661,13 @@ namespace graphene { namespace chain {
           */
          uint32_t  push_applied_operation( const operation& op, bool is_virtual = true );
          void      set_applied_operation_result( uint32_t op_id, const operation_result& r );
-         const vector<optional< operation_history_object > >& get_applied_operations()const;
+         const applied_operation_log& get_applied_operations()const;
+         /**
+          *  @return the results of the operations of each transaction of the block being applied, in the order of
+          *  the transactions. The transactions of the block do not carry their results, like
+          *  get_applied_operations() these are available to @ref applied_block observers.
+          */
+         const vector< vector<operation_result> >& get_applied_transaction_results()const;
 
          /**
           *  This signal is emitted after all operations and virtual operation for a
@@ -647,6 +703,45 @@ namespace graphene { namespace chain {
          fc::signal<void(const vector<object_id_type>&,
                          const vector<const object*>&, const flat_set<account_id_type>&)>  removed_objects;
 
+         using read_only_block_observer = std::function<void(const applied_block_record&)>;
+
+         /**
+          *  Register an observer which only consumes the record of each applied block and never reads or
+          *  writes the database. Unlike callbacks connected to @ref applied_block, these observers run on
+          *  worker threads, so they do not add to block application latency. Each observer processes the
+          *  blocks one at a time in the order they are applied. All of them have completed before
+          *  push_block() or generate_block() changes any state, which includes all blocks applied by the
+          *  previous call when it switched forks.
+          */
+         void add_read_only_block_observer( read_only_block_observer observer );
+
+         /// Block until all read-only block observers have finished processing the last applied block
+         void wait_for_read_only_block_observers();
+
+         /**
+          *  Set the number of worker threads for read-only calls, 0 to run them on the calling thread.
+          *  Must not be called while read-only calls are in progress.
+          */
+         void set_read_only_threads( uint16_t thread_count );
+
+         /**
+          *  Run a call which only reads the database on a read-only worker thread, and wait for its result.
+          *  The call sees the state between two modifications of the chain, and modifications wait for the
+          *  running read-only calls to finish. Runs the call directly if no worker threads are configured or
+          *  if the calling task is already reading or writing the chain state.
+          */
+         template<typename Lambda>
+         auto run_read_only( Lambda&& call )const -> decltype( call() )
+         {
+            fc::thread* worker = get_read_only_thread();
+            if( worker == nullptr )
+               return call();
+            return worker->async( [this,&call]() {
+               chain_state_lock::read_guard guard( _state_lock );
+               return call();
+            }, "read-only call" ).wait();
+         }
+
          ///@{
          /**
           *  This method validates transactions without adding it to the pending state.
@@ -685,6 +780,9 @@ namespace graphene { namespace chain {
       private:
          template<typename Trx>
          void _precompute_parallel( const Trx* trx, const size_t count, const uint32_t skip )const;
+         /// Like _precompute_parallel(), and also calculates the data derived from the transactions into @p derived
+         void _precompute_block_transactions( const processed_transaction* trx, const size_t count,
+                                              const uint32_t skip, transaction_derived_data* derived )const;
 
       protected:
          // Mark pop_undo() as protected -- we do not want outside calling pop_undo(),
@@ -707,7 +805,16 @@ namespace graphene { namespace chain {
 
       private:
          void                  _apply_block( const signed_block& next_block );
+         /// The steps of applying a block after its transactions have been applied
+         void                  _apply_block_steps( const signed_block& next_block,
+                                                   const witness_object& signing_witness, bool maint_needed,
+                                                   apply_profiler::lap_timer& timer );
          processed_transaction _apply_transaction( const signed_transaction& trx );
+         /// Apply a transaction like @ref _apply_transaction without copying it
+         /// @return the results of its operations
+         vector<operation_result> _apply_transaction_results( const signed_transaction& trx );
+         /// @return the cache of authority checks, cleared if any account authority has changed since it was filled
+         authority_check_cache& get_authority_check_cache();
 
          /// Validate, evaluate and apply a virtual operation using a temporary undo_database session,
          /// if fail, rewind any changes made
@@ -727,6 +834,9 @@ namespace graphene { namespace chain {
 
       protected:
          void notify_applied_block( const signed_block& block );
+         /// Moves the applied operations and transaction results into a record with a copy of @p block and
+         /// dispatches it to read-only observers, without copying anything if there are none
+         void notify_read_only_block_observers( const signed_block& block );
          void notify_on_pending_transaction( const signed_transaction& tx );
          void notify_changed_objects();
 
@@ -775,6 +885,12 @@ namespace graphene { namespace chain {
 
          vector< processed_transaction >        _pending_tx;
          fork_database                          _fork_db;
+         /// Packed copies of the transactions in the dupe-check index, see @ref get_recent_transaction
+         mutable recent_transaction_cache       _recent_transactions;
+         /// Deadlines of the objects processed at the end of each block, maintained by secondary indexes
+         expiration_schedule                    _expiration_schedule;
+         /// Hard forks passed at the current head block, maintained by a secondary index
+         hardfork_state                         _hardfork_state;
 
          /**
           *  Note: we can probably store blocks by block num rather than
@@ -793,7 +909,20 @@ namespace graphene { namespace chain {
           * order they occur and is cleared after the applied_block signal is
           * emited.
           */
-         vector<optional<operation_history_object> >  _applied_ops;
+         applied_operation_log                        _applied_ops;
+         /// Results of the operations of the transactions of the current block, cleared like @ref _applied_ops
+         vector< vector<operation_result> >           _applied_trx_results;
+
+         vector<read_only_block_observer>  _read_only_block_observers;
+         /// Tasks of read-only block observers, one per observer, for the last applied block
+         vector<fc::future<void>>          _read_only_block_notifications;
+
+         /// @return the worker thread for the next read-only call, or nullptr to run it on the calling thread
+         fc::thread* get_read_only_thread()const;
+
+         mutable chain_state_lock                _state_lock;
+         vector<unique_ptr<fc::thread>>          _read_only_threads;
+         mutable std::atomic<uint32_t>           _next_read_only_thread { 0 };
 
       public:
          fc::time_point_sec                _current_block_time;
@@ -817,6 +946,9 @@ namespace graphene { namespace chain {
          /// Set it to true to provide accurate data to API clients, set to false to have better performance.
          bool                              _track_standby_votes = true;
 
+         /// Whether to take over the state built while generating a block when pushing that block
+         bool                              _reuse_generated_block_state = true;
+
          /**
           * Whether database is successfully opened or not.
           *
@@ -829,6 +961,20 @@ namespace graphene { namespace chain {
          /// Counts nested undo sessions due to (for example) proposal updates or order-sends-order executions
          uint32_t                          _undo_session_nesting_depth = 0;
 
+         /// Latency statistics of applied operations and block steps, only exists when profiling is enabled
+         unique_ptr<apply_profiler>        _apply_profiler;
+
+         /// Checks of required active authorities of transactions in the current block, see
+         /// @ref get_authority_check_cache
+         authority_check_cache                   _authority_check_cache;
+         /// The account authority version the entries of @ref _authority_check_cache were created with
+         uint64_t                                _authority_check_cache_version = 0;
+         const account_authority_version_index*  _account_authority_versions = nullptr;
+         /// Tracks whether the approvals of proposals might satisfy their required authorities
+         const proposal_authorization_index*     _proposal_authorizations = nullptr;
+         /// Call orders of each market sorted by collateralization, see @ref get_call_orders_by_collateral
+         const call_order_collateral_index*      _call_orders_by_collateral = nullptr;
+
          /// Tracks assets affected by esher-core issue #453 before hard fork #615 in one block
          flat_set<asset_id_type>           _issue_453_affected_assets;
 
@@ -844,6 +990,29 @@ namespace graphene { namespace chain {
       public:
          /// Enable or disable tracking of votes of standby witnesses and committee members
          inline void enable_standby_votes_tracking(bool enable)  { _track_standby_votes = enable; }
+
+         /// Enable or disable latency profiling of operations, evaluators and block steps, disabling drops all data
+         void enable_apply_profiler(bool enable);
+         /// @return the latency profiler, or null if profiling is disabled
+         inline apply_profiler* get_apply_profiler()const { return _apply_profiler.get(); }
+
+         /// Limit the estimated memory used by blocks in the fork database, 0 for no limit
+         inline void set_fork_db_max_memory( uint64_t bytes ) { _fork_db.set_max_memory( bytes ); }
+         inline fork_database_metrics get_fork_db_metrics()const { return _fork_db.get_metrics(); }
+
+         /// @return the deadlines of the objects processed at the end of each block
+         inline const expiration_schedule& get_expiration_schedule()const { return _expiration_schedule; }
+
+         /// @return which of the hard forks checked by the market engine have passed at the current head block
+         inline const hardfork_state& get_hardfork_state()const { return _hardfork_state; }
+
+         /// @return the index of call orders of each market sorted by collateralization, least collateralized first
+         inline const call_order_collateral_index& get_call_orders_by_collateral()const
+         { return *_call_orders_by_collateral; }
+
+         /// @return the index used to skip authority checks of proposals which are not sufficiently approved
+         inline const proposal_authorization_index& get_proposal_authorization_index()const
+         { return *_proposal_authorizations; }
    };
 
 } }
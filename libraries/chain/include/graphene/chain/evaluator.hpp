@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  */
 #pragma once
+#include <graphene/chain/apply_profiler.hpp>
 #include <graphene/chain/exceptions.hpp>
 #include <graphene/chain/transaction_evaluation_state.hpp>
 #include <graphene/protocol/operations.hpp>
@@ -70,6 +71,9 @@ namespace graphene { namespace chain {
 
       database& db()const;
 
+      /// Returns the profiler of the database, or null if profiling is disabled
+      apply_profiler* get_apply_profiler()const;
+
       //void check_required_authorities(const operation& op);
    protected:
       /**
@@ -148,6 +152,7 @@ namespace graphene { namespace chain {
       {
          auto* eval = static_cast<DerivedEvaluator*>(this);
          const auto& op = o.get<typename DerivedEvaluator::operation_type>();
+         apply_profiler::lap_timer timer( get_apply_profiler() );
 
          prepare_fee(op.fee_payer(), op.fee);
          if( !trx_state->skip_fee_schedule_check )
@@ -158,8 +163,12 @@ namespace graphene { namespace chain {
                        "Insufficient Fee Paid",
                        ("core_fee_paid",core_fee_paid)("required", required_fee) );
          }
+         timer.lap( o.which(), apply_profiler::evaluator_phase::fee );
+
+         auto result = eval->do_evaluate(op);
+         timer.lap( o.which(), apply_profiler::evaluator_phase::evaluate );
 
-         return eval->do_evaluate(op);
+         return result;
       }
 
       virtual operation_result apply(const operation& o) final override
@@ -167,12 +176,16 @@ namespace graphene { namespace chain {
          auto* eval = static_cast<DerivedEvaluator*>(this);
          const auto& op = o.get<typename DerivedEvaluator::operation_type>();
 
+         apply_profiler::lap_timer timer( get_apply_profiler() );
+
          convert_fee();
          pay_fee();
+         timer.lap( o.which(), apply_profiler::evaluator_phase::fee );
 
          auto result = eval->do_apply(op);
 
          db_adjust_balance(op.fee_payer(), -fee_from_account);
+         timer.lap( o.which(), apply_profiler::evaluator_phase::apply );
 
          return result;
       }
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/db/index.hpp>
+#include <graphene/protocol/types.hpp>
+
+#include <array>
+#include <map>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  @brief Tracks the deadlines of objects which are processed by time at the end of each block, so that a
+    *         block can tell in constant time whether anything is due and which kinds of objects are
+    *
+    *  Deadlines are added and removed by @ref expiration_schedule_index instances, which follow the object
+    *  indexes, including undo and loading from disk. Each of them only touches the deadlines of its own type, so
+    *  that indexes can be loaded in parallel. The objects themselves are still processed through the ordered
+    *  indexes of their types, in the same order as before.
+    */
+   class expiration_schedule
+   {
+      public:
+         enum class deadline_type : uint8_t
+         {
+            proposal,
+            limit_order,
+            htlc,
+            withdraw_permission,
+            credit_offer,
+            credit_deal,
+            ticket,
+            DEADLINE_TYPE_COUNT
+         };
+
+         /// The deadlines of one type
+         class deadline_set
+         {
+            public:
+               void add( fc::time_point_sec deadline );
+               void remove( fc::time_point_sec deadline );
+               void clear() { _deadlines.clear(); _size = 0; }
+
+               /// @return whether any deadline is at or before @p now
+               bool is_due( fc::time_point_sec now )const
+               {
+                  return !_deadlines.empty() && _deadlines.begin()->first <= now;
+               }
+               /// @return the number of deadlines
+               size_t size()const { return _size; }
+
+            private:
+               /// Number of deadlines at each time
+               std::map< fc::time_point_sec, uint32_t >  _deadlines;
+               size_t                                    _size = 0;
+         };
+
+         deadline_set& deadlines_of( deadline_type type ) { return _deadline_sets[ size_t(type) ]; }
+         void clear();
+
+         /// @return whether any deadline is at or before @p now
+         bool any_due( fc::time_point_sec now )const;
+         /// @return whether any deadline of the given type is at or before @p now
+         bool is_due( deadline_type type, fc::time_point_sec now )const
+         {
+            return _deadline_sets[ size_t(type) ].is_due( now );
+         }
+
+         /// @return the number of deadlines
+         size_t size()const;
+
+      private:
+         std::array< deadline_set, size_t(deadline_type::DEADLINE_TYPE_COUNT) > _deadline_sets;
+   };
+
+   /**
+    *  @brief Adds the deadlines of the objects of an index to an @ref expiration_schedule
+    *
+    *  @tparam ObjectType the type of the objects in the index
+    *  @tparam Type the type of the deadlines
+    *  @tparam GetDeadline returns the deadline of an object, @ref fc::time_point_sec::maximum if it has none
+    */
+   template< typename ObjectType, expiration_schedule::deadline_type Type,
+             fc::time_point_sec (*GetDeadline)( const ObjectType& ) >
+   class expiration_schedule_index : public graphene::db::secondary_index
+   {
+      public:
+         explicit expiration_schedule_index( expiration_schedule& schedule )
+         : _deadlines( schedule.deadlines_of( Type ) ) {}
+
+         void object_inserted( const graphene::db::object& obj ) override
+         {
+            add( deadline_of( obj ) );
+         }
+         void object_removed( const graphene::db::object& obj ) override
+         {
+            remove( deadline_of( obj ) );
+         }
+         void about_to_modify( const graphene::db::object& before ) override
+         {
+            _deadline_before = deadline_of( before );
+         }
+         void object_modified( const graphene::db::object& after ) override
+         {
+            const fc::time_point_sec deadline = deadline_of( after );
+            if( deadline == _deadline_before )
+               return;
+            remove( _deadline_before );
+            add( deadline );
+         }
+
+      private:
+         static fc::time_point_sec deadline_of( const graphene::db::object& obj )
+         {
+            return GetDeadline( static_cast<const ObjectType&>( obj ) );
+         }
+         void add( fc::time_point_sec deadline )
+         {
+            if( deadline != fc::time_point_sec::maximum() )
+               _deadlines.add( deadline );
+         }
+         void remove( fc::time_point_sec deadline )
+         {
+            if( deadline != fc::time_point_sec::maximum() )
+               _deadlines.remove( deadline );
+         }
+
+         expiration_schedule::deadline_set&  _deadlines;
+         fc::time_point_sec                  _deadline_before;
+   };
+
+} } // graphene::chain
@@ -45,9 +45,13 @@ namespace graphene { namespace chain {
       block_id_type previous_id()const { return data.previous; }
 
       weak_ptr< fork_item > prev;
+      /// An earlier ancestor, to find ancestors in logarithmic time, see @ref fork_database::fetch_ancestor
+      weak_ptr< fork_item > skip;
       uint32_t              num;    // initialized in ctor
       block_id_type         id;
       signed_block          data;
+      /// Estimated memory used by this item, set when the item is pushed
+      uint64_t              memory_size = 0;
 
       // contains witness block signing keys scheduled *after* the block has been applied
       shared_ptr< vector< pair< witness_id_type, public_key_type > > > scheduled_witnesses;
@@ -56,6 +60,16 @@ namespace graphene { namespace chain {
    };
    typedef shared_ptr<fork_item> item_ptr;
 
+   /// Statistics of the fork database
+   struct fork_database_metrics
+   {
+      uint32_t items = 0;              ///< number of blocks in the fork database
+      uint64_t memory_usage = 0;       ///< estimated memory used by the blocks, in bytes
+      uint64_t max_memory = 0;         ///< configured limit of memory_usage, 0 if unlimited
+      uint64_t pruned_items = 0;       ///< number of blocks not on the current branch dropped due to the limit
+      uint64_t unlinkable_blocks = 0;  ///< number of pushed blocks which did not link to a known block
+   };
+
 
    /**
     *  As long as blocks are pushed in order the fork
@@ -98,6 +112,20 @@ namespace graphene { namespace chain {
          pair< branch_type, branch_type >  fetch_branch_from(block_id_type first,
                                                              block_id_type second)const;
 
+         /**
+          *  @return the ancestor of @p item with number @p num, @p item itself if it has that number, or null if
+          *          the ancestor is not in the fork database
+          *  @note Runs in logarithmic time of the distance
+          */
+         static item_ptr                  fetch_ancestor( item_ptr item, uint32_t num );
+
+         /**
+          *  @return the latest block which both given blocks are or descend from
+          *  @note Runs in logarithmic time of the distance between the blocks and their common ancestor
+          */
+         item_ptr                         fetch_common_ancestor( const block_id_type& first,
+                                                                 const block_id_type& second )const;
+
          struct block_id;
          struct block_num;
          typedef multi_index_container<
@@ -110,14 +138,36 @@ namespace graphene { namespace chain {
 
          void set_max_size( uint32_t s );
 
+         /**
+          *  Limit the estimated memory used by the blocks. When it is exceeded, the oldest branches which are not the
+          *  branch of the head block are dropped. Branches with blocks in the undo window of the head block, and the
+          *  branch of the block being pushed, are kept, so that they can still become the longest branch.
+          *  @param bytes the limit, 0 for no limit
+          */
+         void set_max_memory( uint64_t bytes );
+
+         fork_database_metrics get_metrics()const;
+
       private:
          /** @return a pointer to the newly pushed item */
          void _push_block(const item_ptr& b );
          void _push_next(const item_ptr& newly_inserted);
+         /// Remove an item from the index and update the memory usage
+         template<typename Index, typename Iterator>
+         void _erase( Index& index, Iterator itr );
+         /// Drop stale branches until the memory usage is within the limit, never the one of @p pushed
+         void _enforce_memory_limit( const item_ptr& pushed = item_ptr() );
 
          uint32_t                 _max_size = 1024;
+         uint64_t                 _max_memory = 0;
+         uint64_t                 _memory_usage = 0;
+         uint64_t                 _pruned_items = 0;
+         uint64_t                 _unlinkable_blocks = 0;
 
          fork_multi_index_type    _index;
          shared_ptr<fork_item>    _head;
    };
 } } // graphene::chain
+
+FC_REFLECT( graphene::chain::fork_database_metrics,
+            (items)(memory_usage)(max_memory)(pruned_items)(unlinkable_blocks) )
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/db/index.hpp>
+#include <graphene/protocol/types.hpp>
+
+#include <bitset>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  @brief Which of the hard forks checked by the market engine have passed, evaluated once for the current
+    *         head block time and next maintenance time instead of on every order
+    *
+    *  Hard forks which were activated at a maintenance interval are passed when the next maintenance time is
+    *  after the hard fork time, the others are passed when the head block time has reached the hard fork time,
+    *  unless noted otherwise.
+    */
+   class hardfork_state
+   {
+      public:
+         enum hardfork : uint8_t
+         {
+            // by next maintenance time
+            core_184,
+            core_338,
+            core_342,
+            core_343,
+            core_453,
+            core_460,
+            core_606,
+            core_625,
+            core_834,
+            core_1270,
+            core_1669,
+            core_2481,
+            // by head block time
+            hf_436,
+            hf_555,
+            hf_615,
+            hf_1774,
+            core_1780,
+            core_1800,
+            core_2582,
+            core_2591,
+            HARDFORK_COUNT
+         };
+
+         hardfork_state() = default;
+         hardfork_state( fc::time_point_sec head_block_time, fc::time_point_sec next_maintenance_time );
+
+         bool passed( hardfork hf )const { return _passed[hf]; }
+         /// @return true if all of the hard forks are passed, i.e. none of the legacy code paths is used
+         bool all_passed()const { return _passed.all(); }
+
+         bool core_184_passed()const  { return _passed[core_184];  } ///< something-for-nothing fill
+         bool core_338_passed()const  { return _passed[core_338];  } ///< margin call fill price
+         bool core_342_passed()const  { return _passed[core_342];  } ///< better rounding
+         bool core_343_passed()const  { return _passed[core_343];  } ///< update call_price on partial fill
+         bool core_453_passed()const  { return _passed[core_453];  } ///< multiple matching issue
+         /// no black swans in prediction markets, passed when the next maintenance time has reached the hard fork time
+         bool core_460_passed()const  { return _passed[core_460];  }
+         bool core_606_passed()const  { return _passed[core_606];  } ///< feed always trigger call
+         bool core_625_passed()const  { return _passed[core_625];  } ///< erratic matching of margin calls
+         bool core_834_passed()const  { return _passed[core_834];  } ///< target collateral ratio option
+         bool core_1270_passed()const { return _passed[core_1270]; } ///< call price caching issue
+         bool core_1669_passed()const { return _passed[core_1669]; } ///< stop using call_price when globally settling
+         bool core_2481_passed()const { return _passed[core_2481]; } ///< match settle orders with margin calls
+         /// margin call only if feed < call price, passed when the head block time is after the hard fork time
+         bool hf_436_passed()const    { return _passed[hf_436];    }
+         bool hf_555_passed()const    { return _passed[hf_555];    } ///< buyback accounts
+         bool hf_615_passed()const    { return _passed[hf_615];    } ///< price feed expiration check
+         bool hf_1774_passed()const   { return _passed[hf_1774];   } ///< market fee sharing check
+         bool core_1780_passed()const { return _passed[core_1780]; } ///< market fee sharing of settle orders
+         bool core_1800_passed()const { return _passed[core_1800]; } ///< temp-account market fee sharing
+         bool core_2582_passed()const { return _passed[core_2582]; } ///< price feed issues
+         bool core_2591_passed()const { return _passed[core_2591]; } ///< tighter peg
+
+      private:
+         std::bitset<HARDFORK_COUNT> _passed;
+   };
+
+   /**
+    *  @brief Keeps a @ref hardfork_state up to date with the dynamic global properties
+    *
+    *  This is a secondary index on the dynamic global property index, so the state also follows undo and
+    *  loading from disk.
+    */
+   class hardfork_state_index : public graphene::db::secondary_index
+   {
+      public:
+         explicit hardfork_state_index( hardfork_state& state ) : _state( state ) {}
+
+         void object_inserted( const graphene::db::object& obj ) override { update( obj ); }
+         void object_removed( const graphene::db::object& obj ) override { _state = hardfork_state(); }
+         void object_modified( const graphene::db::object& after ) override { update( after ); }
+
+      private:
+         void update( const graphene::db::object& obj );
+
+         hardfork_state& _state;
+   };
+
+} } // graphene::chain
@@ -30,6 +30,8 @@
 
 #include <boost/multi_index/composite_key.hpp>
 
+#include <set>
+
 namespace graphene { namespace chain {
 
 using namespace graphene::db;
@@ -292,6 +294,50 @@ typedef generic_index<call_order_object, call_order_multi_index_type>
 typedef generic_index<force_settlement_object, force_settlement_object_multi_index_type>   force_settlement_index;
 typedef generic_index<collateral_bid_object, collateral_bid_object_multi_index_type>       collateral_bid_index;
 
+/**
+ *  @brief Call orders of each market sorted by collateralization, least collateralized first
+ *
+ *  This is a secondary index on the call_order_index. Every order is stored with its collateral ratio as a
+ *  fixed-point number, so that most comparisons are a single integer comparison instead of the cross
+ *  multiplication done when comparing the prices of the by_collateral index. Orders with equal fixed-point
+ *  ratios are compared exactly and then by ID, so within a market the order is the same as in the
+ *  by_collateral index.
+ */
+class call_order_collateral_index : public secondary_index
+{
+   public:
+      struct entry
+      {
+         fc::uint128_t              ratio;      ///< floor( collateral * 2^64 / debt )
+         share_type                 collateral;
+         share_type                 debt;
+         object_id_type             id;
+         const call_order_object*   order = nullptr;
+      };
+      struct entry_compare
+      {
+         bool operator()( const entry& a, const entry& b )const;
+      };
+      using entry_set = std::set<entry, entry_compare>;
+
+      virtual void object_inserted( const object& obj ) override;
+      virtual void object_removed( const object& obj ) override;
+      virtual void about_to_modify( const object& before ) override;
+      virtual void object_modified( const object& after  ) override;
+
+      /// @return the call orders with debt in @p debt_asset and collateral in @p collateral_asset, the reference
+      ///         stays valid while the index exists
+      const entry_set& get_call_orders( asset_id_type debt_asset, asset_id_type collateral_asset )const;
+
+   private:
+      static entry make_entry( const call_order_object& o );
+
+      /// Keyed by debt asset and collateral asset, sets are kept when they become empty so that references stay
+      /// valid
+      mutable map< std::pair<asset_id_type, asset_id_type>, entry_set > _orders;
+      entry _before_modify;
+};
+
 } } // graphene::chain
 
 MAP_OBJECT_ID_TO_TYPE(graphene::chain::limit_order_object)
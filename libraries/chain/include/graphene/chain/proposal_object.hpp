@@ -83,6 +83,91 @@ class required_approval_index : public secondary_index
       flat_set<account_id_type> available_owner_before_modify;
 };
 
+class account_authority_version_index;
+
+/**
+ *  @brief tracks how close the approvals of each proposal are to satisfying its required authorities
+ *
+ *  This is a secondary index on the proposal_index.
+ *
+ *  For every account whose authority a proposal requires, it keeps the weight of the entries of the owner and
+ *  active authorities of the account which might be satisfied by the available approvals of the proposal.
+ *  An entry might be satisfied if an available approval is the account or key of the entry, or one found by
+ *  following the nested account authorities of the entry, at any depth. The weights are
+ *  updated when approvals are added or removed. After the authority of an account has changed, the proposals
+ *  which depend on it are recalculated lazily.
+ *
+ *  The weights are an upper bound of what a full authority check can accumulate, so when one of the required
+ *  accounts can not reach the threshold of its authorities, @ref proposal_object::is_authorized_to_execute
+ *  skips the full check.
+ */
+class proposal_authorization_index : public secondary_index
+{
+   public:
+      proposal_authorization_index( const database& db, const account_authority_version_index& versions )
+      : _db( db ), _versions( versions ) {}
+
+      virtual void object_inserted( const object& obj ) override {}
+      virtual void object_removed( const object& obj ) override;
+      virtual void about_to_modify( const object& before ) override;
+      virtual void object_modified( const object& after  ) override;
+
+      /**
+       *  @return false if the available approvals of the proposal can not satisfy its required authorities,
+       *          true if a full authority check is needed to tell
+       */
+      bool may_be_authorized( const proposal_object& p )const;
+
+   private:
+      /// An entry of a tally, identified by the index of the tally and the index of the entry in it
+      using entry_ref = std::pair<uint32_t, uint32_t>;
+
+      /// The weights of the entries of an authority, and how many available approvals might satisfy each one
+      struct authority_tally
+      {
+         uint32_t              threshold = 0;
+         uint64_t              possible_weight = 0;
+         vector<weight_type>   weights;
+         vector<uint32_t>      supporters;
+      };
+
+      struct authorization_state
+      {
+         bool                                          ignore_custom_operation_required_auths = false;
+         /// Set if the state can not bound the result of the full check
+         bool                                          unbounded = false;
+         flat_set<account_id_type>                     required_active;
+         /// Three tallies for each required account: the account itself, its active and its owner authority
+         vector<authority_tally>                       tallies;
+         /// Also contains every account whose authorities the state depends on
+         map<account_id_type, vector<entry_ref>>       account_entries;
+         map<public_key_type, vector<entry_ref>, pubkey_comparator> key_entries;
+
+         void add_approval( const vector<entry_ref>& entries );
+         void remove_approval( const vector<entry_ref>& entries );
+      };
+
+      authorization_state build_state( const proposal_object& p )const;
+      /// Add @p entry to @p account and to the accounts and keys of its nested authorities
+      void add_nested_entries( authorization_state& state, entry_ref entry, account_id_type account )const;
+      /// Drop the states of the proposals which depend on accounts whose authorities have changed
+      void drop_outdated_states()const;
+      void drop_state( proposal_id_type id )const;
+
+      const database&                                  _db;
+      const account_authority_version_index&           _versions;
+      /// Built when a proposal is checked for the first time, and when account authorities it depends on changed
+      mutable map<proposal_id_type, authorization_state> _states;
+      /// The proposals whose states depend on the authorities of each account
+      mutable map<account_id_type, flat_set<proposal_id_type>> _proposals_by_account;
+      /// The account authority version the states are up to date with
+      mutable uint64_t                                 _version = 0;
+
+      flat_set<account_id_type>                        available_active_before_modify;
+      flat_set<account_id_type>                        available_owner_before_modify;
+      flat_set<public_key_type>                        available_key_before_modify;
+};
+
 struct by_expiration{};
 typedef boost::multi_index_container<
    proposal_object,
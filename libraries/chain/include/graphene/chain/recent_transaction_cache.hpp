@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/protocol/transaction.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+namespace graphene { namespace chain {
+
+   /**
+    *  @brief Keeps recently applied transactions in packed form, so that they can be served to peers and API
+    *         clients
+    *
+    *  The cache is not part of the chain state and is not affected by undo. Its owner decides which of the cached
+    *  transactions are still valid, see @ref database::get_recent_transaction. When the cache exceeds its size
+    *  limit, the transactions added earliest are dropped first.
+    */
+   class recent_transaction_cache
+   {
+      public:
+         explicit recent_transaction_cache( uint64_t max_size = 64 * 1024 * 1024 ) : _max_size( max_size ) {}
+
+         /// Add a transaction, replacing the cached one with the same ID if any
+         void add( const transaction_id_type& id, const signed_transaction& trx );
+         /// @return the cached transaction with the given ID if any
+         fc::optional<signed_transaction> find( const transaction_id_type& id )const;
+         /// Drop transactions whose expiration is earlier than @p now
+         void remove_expired( fc::time_point_sec now );
+
+         /// Limit the size of packed transactions in the cache, in bytes
+         void set_max_size( uint64_t bytes );
+         void clear();
+
+         size_t size()const { return _entries.size(); }
+         /// @return the total size of packed transactions in the cache, in bytes
+         uint64_t packed_size()const { return _packed_size; }
+
+      private:
+         struct entry_type
+         {
+            transaction_id_type  id;
+            fc::time_point_sec   expiration;
+            std::vector<char>    packed;
+         };
+
+         struct by_id;
+         struct by_expiration;
+         typedef boost::multi_index_container<
+            entry_type,
+            boost::multi_index::indexed_by<
+               boost::multi_index::sequenced<>,
+               boost::multi_index::hashed_unique< boost::multi_index::tag<by_id>,
+                  boost::multi_index::member< entry_type, transaction_id_type, &entry_type::id >,
+                  std::hash<transaction_id_type> >,
+               boost::multi_index::ordered_non_unique< boost::multi_index::tag<by_expiration>,
+                  boost::multi_index::member< entry_type, fc::time_point_sec, &entry_type::expiration > >
+            >
+         > entry_index_type;
+
+         void enforce_max_size();
+
+         uint64_t          _max_size;
+         uint64_t          _packed_size = 0;
+         entry_index_type  _entries;
+   };
+
+} } // graphene::chain
@@ -40,15 +40,23 @@ namespace graphene { namespace chain {
     * The purpose of this object is to enable the detection of duplicate transactions. When a transaction is included
     * in a block a transaction_history_object is added. At the end of block processing all transaction_history_objects that
     * have expired can be removed from the index.
+    *
+    * Only the ID, the expiration, the block and the impacted accounts of the transaction are stored, the
+    * transaction itself is kept in a @ref recent_transaction_cache outside of the chain state and fetched from
+    * its block when the cache does not have it.
     */
    class transaction_history_object : public abstract_object<transaction_history_object,
                                                 implementation_ids, impl_transaction_history_object_type>
    {
       public:
-         signed_transaction  trx;
-         transaction_id_type trx_id;
+         transaction_id_type        trx_id;
+         time_point_sec             expiration;
+         /// The block which includes the transaction, or the next one while it is pending
+         uint32_t                   block_num = 0;
+         /// The accounts impacted by the transaction, for object notifications
+         flat_set<account_id_type>  impacted_accounts;
 
-         time_point_sec get_expiration()const { return trx.expiration; }
+         time_point_sec get_expiration()const { return expiration; }
    };
 
    struct by_expiration;
@@ -33,8 +33,33 @@
 
 #include <graphene/protocol/liquidity_pool.hpp>
 
+#include <limits>
+
 namespace graphene { namespace chain {
 
+namespace {
+
+/// @return @p dividend / @p divisor rounded up, computed in 64 bits when the dividend fits, which is the usual case
+fc::uint128_t divide_and_round_up( const fc::uint128_t& dividend, uint64_t divisor )
+{
+   if( dividend <= std::numeric_limits<uint64_t>::max() )
+   {
+      const uint64_t small_dividend = static_cast<uint64_t>( dividend );
+      return small_dividend / divisor + ( 0 == small_dividend % divisor ? 0 : 1 );
+   }
+   return ( dividend + divisor - 1 ) / divisor;
+}
+
+/// @return @p amount * @p percent / GRAPHENE_100_PERCENT rounded down, computed in 64 bits when the product fits
+fc::uint128_t multiply_by_percent( const fc::uint128_t& amount, uint16_t percent )
+{
+   if( amount <= std::numeric_limits<uint64_t>::max() / std::numeric_limits<uint16_t>::max() )
+      return static_cast<uint64_t>( amount ) * percent / GRAPHENE_100_PERCENT;
+   return amount * percent / GRAPHENE_100_PERCENT;
+}
+
+} // namespace
+
 void_result liquidity_pool_create_evaluator::do_evaluate(const liquidity_pool_create_operation& op)
 { try {
    const database& d = db();
@@ -405,7 +430,7 @@ void_result liquidity_pool_exchange_evaluator::do_evaluate(const liquidity_pool_
    {
       share_type new_balance_a = _pool->balance_a + _pool_receives.amount;
       // round up
-      fc::uint128_t new_balance_b = ( _pool->virtual_value + new_balance_a.value - 1 ) / new_balance_a.value;
+      fc::uint128_t new_balance_b = divide_and_round_up( _pool->virtual_value, new_balance_a.value );
       FC_ASSERT( new_balance_b <= _pool->balance_b, "Internal error" );
       delta = fc::uint128_t( _pool->balance_b.value ) - new_balance_b;
       _pool_pays_asset = &asset_obj_b;
@@ -414,13 +439,13 @@ void_result liquidity_pool_exchange_evaluator::do_evaluate(const liquidity_pool_
    {
       share_type new_balance_b = _pool->balance_b + _pool_receives.amount;
       // round up
-      fc::uint128_t new_balance_a = ( _pool->virtual_value + new_balance_b.value - 1 ) / new_balance_b.value;
+      fc::uint128_t new_balance_a = divide_and_round_up( _pool->virtual_value, new_balance_b.value );
       FC_ASSERT( new_balance_a <= _pool->balance_a, "Internal error" );
       delta = fc::uint128_t( _pool->balance_a.value ) - new_balance_a;
       _pool_pays_asset = &asset_obj_a;
    }
 
-   fc::uint128_t pool_taker_fee = delta * _pool->taker_fee_percent / GRAPHENE_100_PERCENT;
+   fc::uint128_t pool_taker_fee = multiply_by_percent( delta, _pool->taker_fee_percent );
    FC_ASSERT( pool_taker_fee <= delta, "Taker fee percent of the pool is too high" );
 
    _pool_pays = asset( static_cast<int64_t>( delta - pool_taker_fee ), op.min_to_receive.asset_id );
@@ -451,9 +476,12 @@ generic_exchange_operation_result liquidity_pool_exchange_evaluator::do_apply(
    // the share asset owner's registrar and referrer will get the shared maker market fee.
    // For _pool_pays_asset, if market fee sharing is enabled,
    // the trader's registrar and referrer will get the shared taker market fee.
-   d.pay_market_fees( &_pool->share_asset(d).issuer(d), *_pool_receives_asset, op.amount_to_sell, true,
-                      _maker_market_fee );
-   d.pay_market_fees( fee_paying_account, *_pool_pays_asset, _pool_pays, false, _taker_market_fee );
+   // Paying a zero fee changes nothing, so the lookups are skipped for pools of assets without market fees.
+   if( _maker_market_fee.amount > 0 )
+      d.pay_market_fees( &_pool->share_asset(d).issuer(d), *_pool_receives_asset, op.amount_to_sell, true,
+                         _maker_market_fee );
+   if( _taker_market_fee.amount > 0 )
+      d.pay_market_fees( fee_paying_account, *_pool_pays_asset, _pool_pays, false, _taker_market_fee );
 
    const auto old_virtual_value = _pool->virtual_value;
    if( op.amount_to_sell.asset_id == _pool->asset_a )
@@ -306,6 +306,71 @@ share_type call_order_object::get_max_debt_to_cover( price match_price,
 
 } FC_CAPTURE_AND_RETHROW( (*this)(feed_price)(match_price)(maintenance_collateral_ratio) ) }
 
+bool call_order_collateral_index::entry_compare::operator()( const entry& a, const entry& b )const
+{
+   if( a.ratio != b.ratio )
+      return a.ratio < b.ratio;
+   // same as comparing the collateralization prices
+   const auto amult = fc::uint128_t( b.debt.value ) * a.collateral.value;
+   const auto bmult = fc::uint128_t( a.debt.value ) * b.collateral.value;
+   if( amult != bmult )
+      return amult < bmult;
+   return a.id < b.id;
+}
+
+call_order_collateral_index::entry call_order_collateral_index::make_entry( const call_order_object& o )
+{
+   entry e;
+   // the ratio is monotonic in collateral / debt, so it never contradicts the exact comparison
+   // Note: debt is only 0 right before the order is removed
+   e.ratio = ( o.debt.value > 0 ) ? ( ( fc::uint128_t( o.collateral.value ) << 64 ) / o.debt.value )
+                                  : ~fc::uint128_t( 0 );
+   e.collateral = o.collateral;
+   e.debt = o.debt;
+   e.id = o.id;
+   e.order = &o;
+   return e;
+}
+
+void call_order_collateral_index::object_inserted( const object& obj )
+{
+   assert( dynamic_cast<const call_order_object*>(&obj) ); // for debug only
+   const call_order_object& o = static_cast<const call_order_object&>(obj);
+   _orders[ std::make_pair( o.debt_type(), o.collateral_type() ) ].insert( make_entry( o ) );
+}
+
+void call_order_collateral_index::object_removed( const object& obj )
+{
+   assert( dynamic_cast<const call_order_object*>(&obj) ); // for debug only
+   const call_order_object& o = static_cast<const call_order_object&>(obj);
+   auto itr = _orders.find( std::make_pair( o.debt_type(), o.collateral_type() ) );
+   if( itr != _orders.end() )
+      itr->second.erase( make_entry( o ) );
+}
+
+void call_order_collateral_index::about_to_modify( const object& before )
+{
+   assert( dynamic_cast<const call_order_object*>(&before) ); // for debug only
+   _before_modify = make_entry( static_cast<const call_order_object&>(before) );
+}
+
+void call_order_collateral_index::object_modified( const object& after )
+{
+   assert( dynamic_cast<const call_order_object*>(&after) ); // for debug only
+   const call_order_object& o = static_cast<const call_order_object&>(after);
+   // the market of a call order never changes
+   entry_set& orders = _orders[ std::make_pair( o.debt_type(), o.collateral_type() ) ];
+   orders.erase( _before_modify );
+   orders.insert( make_entry( o ) );
+}
+
+const call_order_collateral_index::entry_set& call_order_collateral_index::get_call_orders(
+      asset_id_type debt_asset, asset_id_type collateral_asset )const
+{
+   // an empty set is added if not found, so that the reference stays valid when orders are added later
+   return _orders[ std::make_pair( debt_asset, collateral_asset ) ];
+}
+
 FC_REFLECT_DERIVED_NO_TYPENAME( graphene::chain::limit_order_object,
                     (graphene::db::object),
                     (expiration)(seller)(for_sale)(sell_price)(filled_amount)(deferred_fee)(deferred_paid_fee)
@@ -25,6 +25,8 @@
 #include <graphene/chain/hardfork.hpp>
 #include <graphene/chain/transaction_evaluation_state.hpp>
 #include <graphene/chain/proposal_object.hpp>
+#include <graphene/chain/account_object.hpp>
+#include <graphene/chain/custom_authority_object.hpp>
 #include <graphene/chain/hardfork.hpp>
 
 #include <graphene/protocol/restriction_predicate.hpp>
@@ -33,6 +35,10 @@ namespace graphene { namespace chain {
 
 bool proposal_object::is_authorized_to_execute( database& db ) const
 {
+   // Skip the full check while the approvals can not reach the thresholds of the required authorities
+   if( !db.get_proposal_authorization_index().may_be_authorized( *this ) )
+      return false;
+
    transaction_evaluation_state dry_run_eval( &db );
 
    try {
@@ -141,6 +147,285 @@ void required_approval_index::object_modified( const object& after )
     insert_or_remove_delta( proposal_id, available_owner_before_modify,  p.available_owner_approvals );
 }
 
+void proposal_authorization_index::authorization_state::add_approval( const vector<entry_ref>& entries )
+{
+   for( const auto& e : entries )
+   {
+      authority_tally& tally = tallies[e.first];
+      if( 0 == tally.supporters[e.second]++ )
+         tally.possible_weight += tally.weights[e.second];
+   }
+}
+
+void proposal_authorization_index::authorization_state::remove_approval( const vector<entry_ref>& entries )
+{
+   for( const auto& e : entries )
+   {
+      authority_tally& tally = tallies[e.first];
+      if( 0 == --tally.supporters[e.second] )
+         tally.possible_weight -= tally.weights[e.second];
+   }
+}
+
+void proposal_authorization_index::add_nested_entries( authorization_state& state, entry_ref entry,
+                                                       account_id_type account )const
+{
+   // The authorities are followed regardless of the maximum authority depth: accounts approved while checking
+   // other authorities count at any depth in verify_authority, so a cutoff here could reject what it accepts
+   flat_set<account_id_type> visited_accounts;
+   flat_set<public_key_type> visited_keys;
+   vector<account_id_type> pending( 1, account );
+   visited_accounts.insert( account );
+   for( size_t i = 0; i < pending.size(); ++i )
+   {
+      const account_id_type id = pending[i];
+      state.account_entries[id].push_back( entry );
+      // The temporary account is always approved by the full check
+      if( GRAPHENE_TEMP_ACCOUNT == id )
+         state.unbounded = true;
+      const account_object& acc = id( _db );
+      for( const authority* auth : { &acc.active, &acc.owner } )
+      {
+         // An authority without threshold is satisfied without approvals, and addresses are not tracked
+         if( 0 == auth->weight_threshold || !auth->address_auths.empty() )
+            state.unbounded = true;
+         for( const auto& k : auth->key_auths )
+            if( visited_keys.insert( k.first ).second )
+               state.key_entries[k.first].push_back( entry );
+         for( const auto& a : auth->account_auths )
+            if( visited_accounts.insert( a.first ).second )
+               pending.push_back( a.first );
+      }
+   }
+}
+
+proposal_authorization_index::authorization_state proposal_authorization_index::build_state(
+      const proposal_object& p )const
+{
+   authorization_state state;
+   state.ignore_custom_operation_required_auths = MUST_IGNORE_CUSTOM_OP_REQD_AUTHS( _db.head_block_time() );
+
+   flat_set<account_id_type> required_owner;
+   vector<authority> other;
+   for( const auto& op : p.proposed_transaction.operations )
+      operation_get_required_authorities( op, state.required_active, required_owner, other,
+                                          state.ignore_custom_operation_required_auths );
+   if( !other.empty() )
+   {
+      state.unbounded = true;
+      return state;
+   }
+
+   flat_set<account_id_type> required( state.required_active );
+   required.insert( required_owner.begin(), required_owner.end() );
+   state.tallies.reserve( required.size() * 3 );
+   for( const auto& id : required )
+   {
+      const uint32_t self_tally = static_cast<uint32_t>( state.tallies.size() );
+      state.tallies.emplace_back();
+      state.tallies.back().threshold = 1;
+      state.tallies.back().weights.push_back( 1 );
+      state.account_entries[id].emplace_back( self_tally, 0 );
+      // The temporary account is always approved by the full check
+      if( GRAPHENE_TEMP_ACCOUNT == id )
+         state.unbounded = true;
+
+      const account_object& acc = id( _db );
+      for( const authority* auth : { &acc.active, &acc.owner } )
+      {
+         if( 0 == auth->weight_threshold || !auth->address_auths.empty() )
+            state.unbounded = true;
+         const uint32_t tally_index = static_cast<uint32_t>( state.tallies.size() );
+         state.tallies.emplace_back();
+         authority_tally& tally = state.tallies.back();
+         tally.threshold = auth->weight_threshold;
+         for( const auto& k : auth->key_auths )
+         {
+            state.key_entries[k.first].emplace_back( tally_index, static_cast<uint32_t>( tally.weights.size() ) );
+            tally.weights.push_back( k.second );
+         }
+         for( const auto& a : auth->account_auths )
+         {
+            add_nested_entries( state, entry_ref( tally_index, static_cast<uint32_t>( tally.weights.size() ) ),
+                                a.first );
+            tally.weights.push_back( a.second );
+         }
+      }
+   }
+   if( state.unbounded )
+      return state;
+
+   for( auto& tally : state.tallies )
+      tally.supporters.resize( tally.weights.size(), 0 );
+   for( const auto& approvals : { &p.available_active_approvals, &p.available_owner_approvals } )
+      for( const auto& id : *approvals )
+      {
+         auto itr = state.account_entries.find( id );
+         if( itr != state.account_entries.end() )
+            state.add_approval( itr->second );
+      }
+   for( const auto& key : p.available_key_approvals )
+   {
+      auto itr = state.key_entries.find( key );
+      if( itr != state.key_entries.end() )
+         state.add_approval( itr->second );
+   }
+   return state;
+}
+
+void proposal_authorization_index::drop_state( proposal_id_type id )const
+{
+   auto itr = _states.find( id );
+   if( itr == _states.end() )
+      return;
+   for( const auto& entries : itr->second.account_entries )
+   {
+      auto proposals = _proposals_by_account.find( entries.first );
+      if( proposals == _proposals_by_account.end() )
+         continue;
+      proposals->second.erase( id );
+      if( proposals->second.empty() )
+         _proposals_by_account.erase( proposals );
+   }
+   _states.erase( itr );
+}
+
+void proposal_authorization_index::drop_outdated_states()const
+{
+   const uint64_t version = _versions.get_version();
+   if( version == _version )
+      return;
+   const bool known = _versions.for_each_change_since( _version, [this]( account_id_type account ) {
+      auto proposals = _proposals_by_account.find( account );
+      if( proposals == _proposals_by_account.end() )
+         return;
+      // dropping the states modifies the set
+      const flat_set<proposal_id_type> outdated = proposals->second;
+      for( const auto& id : outdated )
+         drop_state( id );
+   } );
+   if( !known )
+   {
+      _states.clear();
+      _proposals_by_account.clear();
+   }
+   _version = version;
+}
+
+bool proposal_authorization_index::may_be_authorized( const proposal_object& p )const
+{
+   drop_outdated_states();
+   const bool ignore_custom_operation_required_auths = MUST_IGNORE_CUSTOM_OP_REQD_AUTHS( _db.head_block_time() );
+   auto itr = _states.find( p.get_id() );
+   if( itr != _states.end()
+         && itr->second.ignore_custom_operation_required_auths != ignore_custom_operation_required_auths )
+   {
+      drop_state( p.get_id() );
+      itr = _states.end();
+   }
+   if( itr == _states.end() )
+   {
+      itr = _states.emplace( p.get_id(), build_state( p ) ).first;
+      for( const auto& entries : itr->second.account_entries )
+         _proposals_by_account[entries.first].insert( p.get_id() );
+   }
+   const authorization_state& state = itr->second;
+
+   if( state.unbounded )
+      return true;
+
+   // Custom authorities can satisfy required active authorities in ways which are not tracked
+   const auto& custom_auths = _db.get_index_type<custom_authority_index>().indices().get<by_account_custom>();
+   for( const auto& id : state.required_active )
+   {
+      auto custom_itr = custom_auths.lower_bound( id );
+      if( custom_itr != custom_auths.end() && custom_itr->account == id )
+         return true;
+   }
+
+   for( size_t i = 0; i < state.tallies.size(); i += 3 )
+   {
+      bool reachable = false;
+      for( size_t j = i; j < i + 3 && !reachable; ++j )
+         reachable = ( state.tallies[j].possible_weight >= state.tallies[j].threshold );
+      if( !reachable )
+         return false;
+   }
+   return true;
+}
+
+void proposal_authorization_index::object_removed( const object& obj )
+{
+   drop_state( static_cast<const proposal_object&>(obj).get_id() );
+}
+
+void proposal_authorization_index::about_to_modify( const object& before )
+{
+   const proposal_object& p = static_cast<const proposal_object&>(before);
+   available_active_before_modify = p.available_active_approvals;
+   available_owner_before_modify  = p.available_owner_approvals;
+   available_key_before_modify    = p.available_key_approvals;
+}
+
+namespace {
+   /// Calls @p on_added for every element of @p after not in @p before, and @p on_removed for the opposite
+   template< typename Set, typename Added, typename Removed >
+   void for_each_delta( const Set& before, const Set& after, Added on_added, Removed on_removed )
+   {
+      auto b = before.begin();
+      auto a = after.begin();
+      while( b != before.end() || a != after.end() )
+      {
+         if( a == after.end() || (b != before.end() && *b < *a) )
+            on_removed( *b++ );
+         else if( b == before.end() || *a < *b )
+            on_added( *a++ );
+         else
+         {
+            ++a;
+            ++b;
+         }
+      }
+   }
+}
+
+void proposal_authorization_index::object_modified( const object& after )
+{
+   const proposal_object& p = static_cast<const proposal_object&>(after);
+   auto itr = _states.find( p.get_id() );
+   if( itr == _states.end() || itr->second.unbounded )
+      return;
+   authorization_state& state = itr->second;
+
+   auto update_accounts = [&state]( const flat_set<account_id_type>& old_approvals,
+                                    const flat_set<account_id_type>& new_approvals ) {
+      for_each_delta( old_approvals, new_approvals,
+         [&state]( const account_id_type& id ) {
+            auto entries = state.account_entries.find( id );
+            if( entries != state.account_entries.end() )
+               state.add_approval( entries->second );
+         },
+         [&state]( const account_id_type& id ) {
+            auto entries = state.account_entries.find( id );
+            if( entries != state.account_entries.end() )
+               state.remove_approval( entries->second );
+         } );
+   };
+   update_accounts( available_active_before_modify, p.available_active_approvals );
+   update_accounts( available_owner_before_modify, p.available_owner_approvals );
+   for_each_delta( available_key_before_modify, p.available_key_approvals,
+      [&state]( const public_key_type& key ) {
+         auto entries = state.key_entries.find( key );
+         if( entries != state.key_entries.end() )
+            state.add_approval( entries->second );
+      },
+      [&state]( const public_key_type& key ) {
+         auto entries = state.key_entries.find( key );
+         if( entries != state.key_entries.end() )
+            state.remove_approval( entries->second );
+      } );
+}
+
 } } // graphene::chain
 
 FC_REFLECT_DERIVED_NO_TYPENAME( graphene::chain::proposal_object, (graphene::chain::object),
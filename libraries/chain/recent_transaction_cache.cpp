@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/chain/recent_transaction_cache.hpp>
+
+#include <fc/io/raw.hpp>
+
+namespace graphene { namespace chain {
+
+void recent_transaction_cache::add( const transaction_id_type& id, const signed_transaction& trx )
+{
+   // The transaction might have been cached with other signatures, keep the latest ones
+   auto& id_idx = _entries.get<by_id>();
+   auto itr = id_idx.find( id );
+   if( itr != id_idx.end() )
+   {
+      _packed_size -= itr->packed.size();
+      id_idx.erase( itr );
+   }
+
+   entry_type entry;
+   entry.id = id;
+   entry.expiration = trx.expiration;
+   entry.packed = fc::raw::pack( trx );
+   const uint64_t entry_size = entry.packed.size();
+   if( _entries.push_back( std::move(entry) ).second )
+   {
+      _packed_size += entry_size;
+      enforce_max_size();
+   }
+}
+
+fc::optional<signed_transaction> recent_transaction_cache::find( const transaction_id_type& id )const
+{
+   const auto& id_idx = _entries.get<by_id>();
+   auto itr = id_idx.find( id );
+   if( itr == id_idx.end() )
+      return {};
+   return fc::raw::unpack<signed_transaction>( itr->packed );
+}
+
+void recent_transaction_cache::remove_expired( fc::time_point_sec now )
+{
+   auto& exp_idx = _entries.get<by_expiration>();
+   while( !exp_idx.empty() && exp_idx.begin()->expiration < now )
+   {
+      _packed_size -= exp_idx.begin()->packed.size();
+      exp_idx.erase( exp_idx.begin() );
+   }
+}
+
+void recent_transaction_cache::set_max_size( uint64_t bytes )
+{
+   _max_size = bytes;
+   enforce_max_size();
+}
+
+void recent_transaction_cache::clear()
+{
+   _entries.clear();
+   _packed_size = 0;
+}
+
+void recent_transaction_cache::enforce_max_size()
+{
+   while( _packed_size > _max_size && !_entries.empty() )
+   {
+      _packed_size -= _entries.front().packed.size();
+      _entries.pop_front();
+   }
+}
+
+} } // graphene::chain
@@ -85,6 +85,16 @@
 #define GRAPHENE_NET_MAX_INVENTORY_SIZE_IN_MINUTES           2
 
 #define GRAPHENE_NET_MAX_BLOCKS_PER_PEER_DURING_SYNCING      200
+/**
+ * The least number of blocks requested from a peer during syncing, once its throughput
+ * has been measured
+ */
+#define GRAPHENE_NET_MIN_BLOCKS_PER_PEER_DURING_SYNCING      10
+/**
+ * A sync block that another peer still has not delivered after this long, plus the
+ * latency of the peer we are considering, is also requested from that peer if it is faster
+ */
+#define GRAPHENE_NET_SYNC_STRAGGLER_TIMEOUT_MS               2000
 
 /**
  * During normal operation, how many items will be fetched from each
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/net/core_messages.hpp>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace graphene { namespace net {
+
+   /**
+    * @brief A filter of the blocks and transactions known to the client, which the p2p thread can query directly
+    *
+    * The client adds items as it learns about them, and the p2p thread looks them up without calling the client
+    * thread. The most recent items are kept in an exact set. Older ones are kept in a Bloom filter, which can
+    * only tell that an item is unknown, so its positive answers must be resolved by asking the client.
+    *
+    * Both are kept in two generations. When the current generation is full, the older one is cleared and
+    * becomes the current one.
+    *
+    * All methods are thread safe.
+    */
+   class known_items_filter
+   {
+      public:
+         enum class lookup_result
+         {
+            known,   ///< the item is known
+            unknown, ///< the item is not known
+            maybe    ///< the filter can not tell, ask the client
+         };
+
+         known_items_filter();
+
+         /// Add an item which the client knows
+         void add( const item_id& id );
+
+         /**
+          * Set the number of the head block of the client. Blocks with higher numbers are not known, and blocks
+          * with lower numbers which are not covered by the Bloom filter might be.
+          */
+         void set_head_block_num( uint32_t block_num );
+
+         lookup_result lookup( const item_id& id )const;
+
+      private:
+         static constexpr size_t bloom_bits = 1 << 20;
+         static constexpr size_t bloom_hashes = 4;
+         static constexpr size_t bloom_words = bloom_bits / 64;
+         static constexpr size_t bloom_generation_size = 100000;
+         static constexpr size_t exact_generation_size = 10000;
+
+         struct bloom_generation
+         {
+            std::unique_ptr<std::atomic<uint64_t>[]> words { new std::atomic<uint64_t>[bloom_words] };
+            std::atomic<size_t>                      count { 0 };
+            /// Blocks with higher numbers were added to this generation or a later one
+            std::atomic<uint32_t>                    covers_blocks_after { 0 };
+         };
+
+         static std::array<size_t, bloom_hashes> bloom_bits_of( const item_id& id );
+         static bool bloom_contains( const bloom_generation& generation, const item_id& id );
+
+         bloom_generation                 _bloom[2];
+         std::atomic<uint32_t>            _current_bloom { 0 };
+         /// Incremented before and after clearing a generation, so that lookups during a rotation are not trusted
+         std::atomic<uint64_t>            _bloom_epoch { 0 };
+         /// Blocks after this are all in the Bloom filter
+         std::atomic<uint32_t>            _covers_blocks_after { 0 };
+         std::atomic<uint32_t>            _head_block_num { 0 };
+
+         mutable std::mutex               _exact_mutex;
+         std::unordered_set<item_id>      _recent_items;
+         std::unordered_set<item_id>      _previous_recent_items;
+   };
+
+} } // graphene::net
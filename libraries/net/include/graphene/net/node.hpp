@@ -24,6 +24,7 @@
 #pragma once
 
 #include <graphene/net/core_messages.hpp>
+#include <graphene/net/known_items_filter.hpp>
 #include <graphene/net/message.hpp>
 #include <graphene/net/peer_database.hpp>
 
@@ -163,6 +164,11 @@ namespace graphene { namespace net {
          virtual void error_encountered(const std::string& message, const fc::oexception& error) = 0;
          virtual uint8_t get_current_block_interval_in_seconds() const = 0;
 
+         /**
+          *  @return a filter of the items known to the client which can be queried on the p2p thread, to avoid
+          *          calling @ref has_item on the client thread for most items, or null if there is none
+          */
+         virtual std::shared_ptr<const known_items_filter> get_known_items_filter() const { return nullptr; }
    };
 
    /**
@@ -54,6 +54,39 @@ namespace graphene { namespace net
       virtual message get_message_for_item(const item_id& item) = 0;
     };
 
+    /**
+     * Measures how fast a peer delivers the sync blocks we request, to size the requests we send to it
+     */
+    struct sync_throughput_meter
+    {
+      /// Number of requested sync blocks the peer delivered
+      uint64_t         blocks_received = 0;
+      /// Moving average of the delivery rate while requests are in flight
+      double           blocks_per_second = 0;
+      /// Moving average of the time from sending requests to a peer without requests in flight to the first block
+      fc::microseconds latency;
+      /// Number of blocks requested from this peer because the peer they were requested from first was too slow
+      uint64_t         reassigned_requests = 0;
+
+      /// Call when sending requests to the peer while none are in flight
+      void requests_sent( const fc::time_point& now );
+      /// Call when the peer delivers a requested block
+      void block_received( const fc::time_point& now );
+      /// @return whether enough blocks were received to estimate the speed of the peer
+      bool is_measured()const { return blocks_received >= min_samples; }
+      /**
+       * @return the number of blocks to keep requested from the peer, which is the number of blocks it delivers
+       *         within its latency plus one second, or @p max_window if the peer has not been measured yet
+       */
+      uint32_t window( uint32_t min_window, uint32_t max_window )const;
+
+    private:
+      static constexpr uint64_t min_samples = 10;
+      fc::time_point  _requests_sent_time;
+      fc::time_point  _last_block_time;
+      bool            _waiting_for_first_block = false;
+    };
+
     using peer_connection_ptr = std::shared_ptr<peer_connection>;
     class peer_connection : public message_oriented_connection_delegate,
                             public std::enable_shared_from_this<peer_connection>
@@ -225,6 +258,8 @@ namespace graphene { namespace net
       fc::time_point last_sync_item_received_time;
       /// IDs of blocks we've requested from this peer during sync. Fetch from another peer if this peer disconnects
       std::set<item_hash_t> sync_items_requested_from_peer;
+      /// How fast this peer delivers the sync blocks we request
+      sync_throughput_meter sync_throughput;
       /// The hash of the last block  this peer has told us about that the peer knows
       item_hash_t last_block_delegate_has_seen;
       fc::time_point_sec last_block_time_delegate_has_seen;
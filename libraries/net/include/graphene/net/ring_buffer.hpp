@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace graphene { namespace net {
+
+/**
+ * @brief A bounded lock-free queue for passing items between threads
+ *
+ * Any number of threads may push and pop concurrently. Each slot carries a sequence number which tells whether it
+ * is ready to be written or read in the current round, so that producers and consumers only contend on the
+ * head and tail counters.
+ *
+ * @tparam T the type of the items, must be default constructible and movable
+ */
+template<typename T>
+class ring_buffer
+{
+   public:
+      /// @param capacity the maximum number of queued items, rounded up to a power of 2
+      explicit ring_buffer( size_t capacity )
+      {
+         size_t size = 2;
+         while( size < capacity )
+            size <<= 1;
+         _mask = size - 1;
+         _slots.reset( new slot[size] );
+         for( size_t i = 0; i < size; ++i )
+            _slots[i].sequence.store( i, std::memory_order_relaxed );
+      }
+
+      ring_buffer( const ring_buffer& ) = delete;
+      ring_buffer& operator=( const ring_buffer& ) = delete;
+
+      size_t capacity()const { return _mask + 1; }
+
+      /// @return false if the queue is full, in which case @p item is left unchanged
+      bool try_push( T&& item )
+      {
+         size_t pos = _tail.load( std::memory_order_relaxed );
+         slot* s;
+         while( true )
+         {
+            s = &_slots[pos & _mask];
+            const size_t seq = s->sequence.load( std::memory_order_acquire );
+            const auto diff = static_cast<std::ptrdiff_t>( seq ) - static_cast<std::ptrdiff_t>( pos );
+            if( diff == 0 )
+            {
+               if( _tail.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                  break;
+            }
+            else if( diff < 0 )
+               return false;
+            else
+               pos = _tail.load( std::memory_order_relaxed );
+         }
+         s->item = std::move( item );
+         s->sequence.store( pos + 1, std::memory_order_release );
+         return true;
+      }
+
+      /// @return false if the queue is empty
+      bool try_pop( T& item )
+      {
+         size_t pos = _head.load( std::memory_order_relaxed );
+         slot* s;
+         while( true )
+         {
+            s = &_slots[pos & _mask];
+            const size_t seq = s->sequence.load( std::memory_order_acquire );
+            const auto diff = static_cast<std::ptrdiff_t>( seq ) - static_cast<std::ptrdiff_t>( pos + 1 );
+            if( diff == 0 )
+            {
+               if( _head.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                  break;
+            }
+            else if( diff < 0 )
+               return false;
+            else
+               pos = _head.load( std::memory_order_relaxed );
+         }
+         item = std::move( s->item );
+         s->item = T();
+         s->sequence.store( pos + _mask + 1, std::memory_order_release );
+         return true;
+      }
+
+   private:
+      struct slot
+      {
+         std::atomic<size_t> sequence;
+         T                   item;
+      };
+
+      std::unique_ptr<slot[]> _slots;
+      size_t                  _mask;
+      // Keep the counters written by producers and consumers on separate cache lines
+      char                    _padding1[64];
+      std::atomic<size_t>     _tail { 0 };
+      char                    _padding2[64];
+      std::atomic<size_t>     _head { 0 };
+};
+
+} } // graphene::net
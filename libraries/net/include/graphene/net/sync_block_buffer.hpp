@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/net/core_messages.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+
+namespace graphene { namespace net {
+
+   /**
+    * @brief Sync blocks which have been received from peers but not yet passed to the client, because blocks
+    *        that come earlier in the chain are still missing
+    *
+    * Blocks are looked up by ID in constant time and ordered by block number. When the buffer exceeds its size
+    * limit, the blocks with the highest numbers are dropped first since they will be needed last, they have to
+    * be fetched again later.
+    */
+   class sync_block_buffer
+   {
+      public:
+         explicit sync_block_buffer( uint64_t max_size = 512 * 1024 * 1024 ) : _max_size( max_size ) {}
+
+         /// Add a block unless it is already in the buffer, may drop other blocks to stay within the size limit
+         /// @return whether the block has been added and kept
+         bool add( const block_message& block );
+         bool contains( const block_id_type& id )const;
+         /// Remove a block from the buffer and return it
+         fc::optional<block_message> take( const block_id_type& id );
+         /// Remove a block from the buffer
+         void remove( const block_id_type& id );
+
+         size_t size()const { return _blocks.size(); }
+         bool empty()const { return _blocks.empty(); }
+         /// @return the estimated size of the blocks in the buffer, in bytes
+         uint64_t packed_size()const { return _packed_size; }
+         /// @return whether the buffer has reached its size limit
+         bool full()const { return _packed_size >= _max_size; }
+         /// @return the number of blocks dropped because of the size limit
+         uint64_t dropped_blocks()const { return _dropped_blocks; }
+
+         void set_max_size( uint64_t bytes );
+         void clear();
+
+      private:
+         struct entry_type
+         {
+            block_id_type  id;
+            uint32_t       num = 0;
+            uint64_t       packed_size = 0;
+            block_message  block;
+         };
+
+         struct by_id;
+         struct by_num;
+         typedef boost::multi_index_container<
+            entry_type,
+            boost::multi_index::indexed_by<
+               boost::multi_index::hashed_unique< boost::multi_index::tag<by_id>,
+                  boost::multi_index::member< entry_type, block_id_type, &entry_type::id >,
+                  std::hash<block_id_type> >,
+               boost::multi_index::ordered_non_unique< boost::multi_index::tag<by_num>,
+                  boost::multi_index::member< entry_type, uint32_t, &entry_type::num > >
+            >
+         > entry_index_type;
+
+         void enforce_max_size();
+
+         uint64_t          _max_size;
+         uint64_t          _packed_size = 0;
+         uint64_t          _dropped_blocks = 0;
+         entry_index_type  _blocks;
+   };
+
+} } // graphene::net
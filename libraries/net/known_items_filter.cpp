@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/net/known_items_filter.hpp>
+
+#include <graphene/protocol/block.hpp>
+
+#include <limits>
+
+namespace graphene { namespace net {
+
+known_items_filter::known_items_filter()
+{
+   // Nothing is covered until the first head block number is known
+   _covers_blocks_after = std::numeric_limits<uint32_t>::max();
+   for( bloom_generation& generation : _bloom )
+   {
+      generation.covers_blocks_after = std::numeric_limits<uint32_t>::max();
+      for( size_t i = 0; i < bloom_words; ++i )
+         generation.words[i].store( 0 );
+   }
+}
+
+std::array<size_t, known_items_filter::bloom_hashes> known_items_filter::bloom_bits_of( const item_id& id )
+{
+   // The item hashes are cryptographic hashes, so their words can be used as the hash functions of the filter,
+   // except the first word of block IDs which is the block number
+   std::array<size_t, bloom_hashes> bits;
+   for( size_t i = 0; i < bloom_hashes; ++i )
+      bits[i] = ( id.item_hash._hash[i + 1].value() ^ id.item_type ) & ( bloom_bits - 1 );
+   return bits;
+}
+
+bool known_items_filter::bloom_contains( const bloom_generation& generation, const item_id& id )
+{
+   for( size_t bit : bloom_bits_of( id ) )
+   {
+      if( 0 == ( generation.words[bit / 64].load() & ( uint64_t(1) << ( bit % 64 ) ) ) )
+         return false;
+   }
+   return true;
+}
+
+void known_items_filter::add( const item_id& id )
+{
+   std::lock_guard<std::mutex> guard( _exact_mutex );
+
+   if( _recent_items.size() >= exact_generation_size )
+   {
+      _previous_recent_items = std::move( _recent_items );
+      _recent_items.clear();
+   }
+   _recent_items.insert( id );
+
+   uint32_t current = _current_bloom.load();
+   if( _bloom[current].count.load() >= bloom_generation_size )
+   {
+      // Only the current generation remains, then the older one is cleared and becomes the current one
+      const uint32_t older = 1 - current;
+      _covers_blocks_after = _bloom[current].covers_blocks_after.load();
+      ++_bloom_epoch;
+      for( size_t i = 0; i < bloom_words; ++i )
+         _bloom[older].words[i].store( 0 );
+      _bloom[older].count = 0;
+      _bloom[older].covers_blocks_after = _head_block_num.load();
+      _current_bloom = older;
+      ++_bloom_epoch;
+      current = older;
+   }
+
+   bloom_generation& generation = _bloom[current];
+   for( size_t bit : bloom_bits_of( id ) )
+      generation.words[bit / 64].fetch_or( uint64_t(1) << ( bit % 64 ) );
+   ++generation.count;
+}
+
+void known_items_filter::set_head_block_num( uint32_t block_num )
+{
+   std::lock_guard<std::mutex> guard( _exact_mutex );
+   if( _covers_blocks_after.load() == std::numeric_limits<uint32_t>::max() )
+   {
+      // Blocks up to the first head block were never added
+      _covers_blocks_after = block_num;
+      for( bloom_generation& generation : _bloom )
+         generation.covers_blocks_after = block_num;
+   }
+   _head_block_num = block_num;
+}
+
+known_items_filter::lookup_result known_items_filter::lookup( const item_id& id )const
+{
+   {
+      std::lock_guard<std::mutex> guard( _exact_mutex );
+      if( _recent_items.find( id ) != _recent_items.end()
+            || _previous_recent_items.find( id ) != _previous_recent_items.end() )
+         return lookup_result::known;
+   }
+
+   const bool is_block = ( id.item_type == block_message_type );
+   const uint32_t block_num = is_block ? protocol::block_header::num_from_id( id.item_hash ) : 0;
+   if( is_block && block_num > _head_block_num.load() )
+      return lookup_result::unknown;
+
+   const uint64_t epoch_before = _bloom_epoch.load();
+   if( 0 != ( epoch_before % 2 ) )
+      return lookup_result::maybe;
+   const bool maybe_known = bloom_contains( _bloom[0], id ) || bloom_contains( _bloom[1], id );
+   const uint32_t covers_blocks_after = _covers_blocks_after.load();
+   if( _bloom_epoch.load() != epoch_before )
+      return lookup_result::maybe;
+
+   if( maybe_known || ( is_block && block_num <= covers_blocks_after ) )
+      return lookup_result::maybe;
+   return lookup_result::unknown;
+}
+
+} } // graphene::net
@@ -507,10 +507,22 @@ namespace graphene { namespace net { namespace detail {
     bool node_impl::have_already_received_sync_item( const item_hash_t& item_hash )
     {
       VERIFY_CORRECT_THREAD();
-      return std::find_if(_received_sync_items.begin(), _received_sync_items.end(),
-                          [&item_hash]( const graphene::net::block_message& message ) { return message.block_id == item_hash; } ) != _received_sync_items.end() ||
-             std::find_if(_new_received_sync_items.begin(), _new_received_sync_items.end(),
-                          [&item_hash]( const graphene::net::block_message& message ) { return message.block_id == item_hash; } ) != _new_received_sync_items.end();                          ;
+      return _received_sync_items.contains( item_hash );
+    }
+
+    size_t node_impl::get_sync_window( const peer_connection& peer ) const
+    {
+      const size_t max_window = std::max( _max_sync_blocks_per_peer, size_t(1) );
+      const size_t min_window = std::min( _min_sync_blocks_per_peer, max_window );
+      return peer.sync_throughput.window( uint32_t(min_window), uint32_t(max_window) );
+    }
+
+    void node_impl::cancel_sync_request( const item_hash_t& item_hash )
+    {
+      VERIFY_CORRECT_THREAD();
+      // if the block was requested from another peer too, that request is still in flight or already settled
+      if( _reassigned_sync_requests.erase( item_hash ) == 0 )
+        _active_sync_requests.erase( item_hash );
     }
 
     void node_impl::request_sync_item_from_peer( const peer_connection_ptr& peer, const item_hash_t& item_to_request )
@@ -518,6 +530,8 @@ namespace graphene { namespace net { namespace detail {
       VERIFY_CORRECT_THREAD();
       dlog( "requesting item ${item_hash} from peer ${endpoint}", ("item_hash", item_to_request )("endpoint", peer->get_remote_endpoint() ) );
       item_id item_id_to_request( graphene::net::block_message_type, item_to_request );
+      if( peer->sync_items_requested_from_peer.empty() )
+        peer->sync_throughput.requests_sent( fc::time_point::now() );
       _active_sync_requests.insert( active_sync_requests_map::value_type(item_to_request, fc::time_point::now() ) );
       peer->last_sync_item_received_time = fc::time_point::now();
       peer->sync_items_requested_from_peer.insert(item_to_request);
@@ -529,6 +543,8 @@ namespace graphene { namespace net { namespace detail {
       VERIFY_CORRECT_THREAD();
       dlog( "requesting ${item_count} item(s) ${items_to_request} from peer ${endpoint}",
             ("item_count", items_to_request.size())("items_to_request", items_to_request)("endpoint", peer->get_remote_endpoint()) );
+      if( peer->sync_items_requested_from_peer.empty() )
+        peer->sync_throughput.requests_sent( fc::time_point::now() );
       for (const item_hash_t& item_to_request : items_to_request)
       {
         _active_sync_requests.insert( active_sync_requests_map::value_type(item_to_request, fc::time_point::now() ) );
@@ -553,20 +569,62 @@ namespace graphene { namespace net { namespace detail {
           {
             std::set<item_hash_t> sync_items_to_request;
 
-            // for each idle peer that we're syncing with
+            // for each peer that we're syncing with which can take more requests, i.e. which is not waiting
+            // for other items and has less than half of its window of sync blocks in flight
             fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
+            const fc::time_point now = fc::time_point::now();
             for( const peer_connection_ptr& peer : _active_connections )
             {
+              const size_t window = get_sync_window(*peer);
+              const size_t in_flight = peer->sync_items_requested_from_peer.size();
               if( peer->we_need_sync_items_from_peer &&
                   // if we've already scheduled a request for this peer, don't consider scheduling another
                   sync_item_requests_to_send.find(peer) == sync_item_requests_to_send.end() &&
-                  peer->idle() )
+                  peer->items_requested_from_peer.empty() && !peer->item_ids_requested_from_peer &&
+                  in_flight * 2 <= window )
               {
                 if (!peer->inhibit_fetching_sync_blocks)
                 {
+                  const size_t requests_to_send = window - in_flight;
+                  // the first item the peer has is the next block we need from it, if another peer is slow to
+                  // deliver it, all blocks after it wait in the backlog
+                  if( !peer->ids_of_items_to_get.empty() )
+                  {
+                    const item_hash_t& next_item = peer->ids_of_items_to_get.front();
+                    auto request_itr = _active_sync_requests.find(next_item);
+                    if( request_itr != _active_sync_requests.end() &&
+                        request_itr->second + fc::milliseconds(GRAPHENE_NET_SYNC_STRAGGLER_TIMEOUT_MS)
+                                            + peer->sync_throughput.latency < now &&
+                        peer->sync_items_requested_from_peer.find(next_item) == peer->sync_items_requested_from_peer.end() &&
+                        _reassigned_sync_requests.find(next_item) == _reassigned_sync_requests.end() &&
+                        peer->sync_throughput.is_measured() )
+                    {
+                      for( const peer_connection_ptr& slow_peer : _active_connections )
+                      {
+                        if( slow_peer->sync_items_requested_from_peer.find(next_item)
+                              != slow_peer->sync_items_requested_from_peer.end() )
+                        {
+                          if( slow_peer->sync_throughput.blocks_per_second < peer->sync_throughput.blocks_per_second )
+                          {
+                            dlog( "requesting sync item ${id} again from ${fast} because ${slow} is too slow",
+                                  ("id", next_item)("fast", peer->get_remote_endpoint())
+                                  ("slow", slow_peer->get_remote_endpoint()) );
+                            sync_item_requests_to_send[peer].push_back(next_item);
+                            sync_items_to_request.insert(next_item);
+                            _reassigned_sync_requests.insert(next_item);
+                            ++peer->sync_throughput.reassigned_requests;
+                          }
+                          break;
+                        }
+                      }
+                    }
+                  }
+
                   // loop through the items it has that we don't yet have on our blockchain
                   for( const auto& item_to_potentially_request : peer->ids_of_items_to_get )
                   {
+                    if (sync_item_requests_to_send[peer].size() >= requests_to_send)
+                      break;
                     // if we don't already have this item in our temporary storage
                     // and we haven't requested from another syncing peer
                     if( // already got it, but for some reson it's still in our list of items to fetch
@@ -574,15 +632,17 @@ namespace graphene { namespace net { namespace detail {
                         // we have already decided to request it from another peer during this iteration
                         sync_items_to_request.find(item_to_potentially_request) == sync_items_to_request.end() &&
                         // we've requested it in a previous iteration and we're still waiting for it to arrive
-                        _active_sync_requests.find(item_to_potentially_request) == _active_sync_requests.end() )
+                        _active_sync_requests.find(item_to_potentially_request) == _active_sync_requests.end() &&
+                        // a copy of it is still on the way from another peer
+                        _reassigned_sync_requests.find(item_to_potentially_request) == _reassigned_sync_requests.end() )
                     {
                       // then schedule a request from this peer
                       sync_item_requests_to_send[peer].push_back(item_to_potentially_request);
                       sync_items_to_request.insert( item_to_potentially_request );
-                      if (sync_item_requests_to_send[peer].size() >= _max_sync_blocks_per_peer)
-                        break;
                     }
                   }
+                  if (sync_item_requests_to_send[peer].empty())
+                    sync_item_requests_to_send.erase(peer);
                 }
               }
             }
@@ -2745,7 +2805,7 @@ namespace graphene { namespace net { namespace detail {
       auto sync_item_iter = originating_peer->sync_items_requested_from_peer.find(requested_item.item_hash);
       if (sync_item_iter != originating_peer->sync_items_requested_from_peer.end())
       {
-        _active_sync_requests.erase(*sync_item_iter);
+        cancel_sync_request(*sync_item_iter);
         originating_peer->sync_items_requested_from_peer.erase(sync_item_iter);
 
         if (originating_peer->peer_needs_sync_items_from_us)
@@ -2928,7 +2988,7 @@ namespace graphene { namespace net { namespace detail {
       if (!originating_peer->sync_items_requested_from_peer.empty())
       {
         for (auto sync_item : originating_peer->sync_items_requested_from_peer)
-          _active_sync_requests.erase(sync_item);
+          cancel_sync_request(sync_item);
         trigger_fetch_sync_items_loop();
       }
 
@@ -3178,87 +3238,90 @@ namespace graphene { namespace net { namespace detail {
 
       do
       {
-        std::copy(std::make_move_iterator(_new_received_sync_items.begin()),
-                  std::make_move_iterator(_new_received_sync_items.end()),
-                  std::front_inserter(_received_sync_items));
-        _new_received_sync_items.clear();
         dlog("currently ${count} sync items to consider", ("count", _received_sync_items.size()));
 
         block_processed_this_iteration = false;
-        for (auto received_block_iter = _received_sync_items.begin();
-             received_block_iter != _received_sync_items.end();
-             ++received_block_iter)
-        {
+        if (_received_sync_items.empty())
+          break;
 
-          // find out if this block is the next block on the active chain or one of the forks
-          bool potential_first_block = false;
+        // find out if one of the received blocks is the next block on the active chain or one of the forks,
+        // i.e. the next block to get from one of the peers
+        fc::optional<graphene::net::block_message> first_block;
+        {
+          fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
+          for (const peer_connection_ptr& peer : _active_connections)
           {
-            fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-            for (const peer_connection_ptr& peer : _active_connections)
+            if (!peer->ids_of_items_to_get.empty())
             {
-               if (!peer->ids_of_items_to_get.empty() &&
-                     peer->ids_of_items_to_get.front() == received_block_iter->block_id)
-               {
-                  potential_first_block = true;
-                  peer->ids_of_items_to_get.pop_front();
-                  peer->ids_of_items_being_processed.insert(received_block_iter->block_id);
-               }
+              first_block = _received_sync_items.take(peer->ids_of_items_to_get.front());
+              if (first_block.valid())
+                break;
             }
           }
-
-          // if it is, process it, remove it from all sync peers lists
-          if (potential_first_block)
+          if (first_block.valid())
           {
-            // we can get into an interesting situation near the end of synchronization.  We can be in
-            // sync with one peer who is sending us the last block on the chain via a regular inventory
-            // message, while at the same time still be synchronizing with a peer who is sending us the
-            // block through the sync mechanism.  Further, we must request both blocks because
-            // we don't know they're the same (for the peer in normal operation, it has only told us the
-            // message id, for the peer in the sync case we only known the block_id).
-            if (std::find(_most_recent_blocks_accepted.begin(), _most_recent_blocks_accepted.end(),
-                          received_block_iter->block_id) == _most_recent_blocks_accepted.end())
+            for (const peer_connection_ptr& peer : _active_connections)
             {
-              graphene::net::block_message block_message_to_process = *received_block_iter;
-              _received_sync_items.erase(received_block_iter);
-              _handle_message_calls_in_progress.emplace_back(fc::async([this, block_message_to_process](){
-                send_sync_block_to_node_delegate(block_message_to_process);
-              }, "send_sync_block_to_node_delegate"));
-              ++blocks_processed;
-              block_processed_this_iteration = true;
+              if (!peer->ids_of_items_to_get.empty() &&
+                    peer->ids_of_items_to_get.front() == first_block->block_id)
+              {
+                peer->ids_of_items_to_get.pop_front();
+                peer->ids_of_items_being_processed.insert(first_block->block_id);
+              }
             }
-            else
+          }
+        }
+
+        // if it is, process it, remove it from all sync peers lists
+        if (first_block.valid())
+        {
+          // we can get into an interesting situation near the end of synchronization.  We can be in
+          // sync with one peer who is sending us the last block on the chain via a regular inventory
+          // message, while at the same time still be synchronizing with a peer who is sending us the
+          // block through the sync mechanism.  Further, we must request both blocks because
+          // we don't know they're the same (for the peer in normal operation, it has only told us the
+          // message id, for the peer in the sync case we only known the block_id).
+          if (std::find(_most_recent_blocks_accepted.begin(), _most_recent_blocks_accepted.end(),
+                        first_block->block_id) == _most_recent_blocks_accepted.end())
+          {
+            graphene::net::block_message block_message_to_process = std::move(*first_block);
+            _handle_message_calls_in_progress.emplace_back(fc::async([this, block_message_to_process](){
+              send_sync_block_to_node_delegate(block_message_to_process);
+            }, "send_sync_block_to_node_delegate"));
+            ++blocks_processed;
+            block_processed_this_iteration = true;
+          }
+          else
+          {
+            dlog("Already received and accepted this block (presumably through normal inventory mechanism), treating it as accepted");
+            std::vector< peer_connection_ptr > peers_needing_next_batch;
+            fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
+            for (const peer_connection_ptr& peer : _active_connections)
             {
-              dlog("Already received and accepted this block (presumably through normal inventory mechanism), treating it as accepted");
-              std::vector< peer_connection_ptr > peers_needing_next_batch;
-              fc::scoped_lock<fc::mutex> lock(_active_connections.get_mutex());
-              for (const peer_connection_ptr& peer : _active_connections)
+              auto items_being_processed_iter = peer->ids_of_items_being_processed.find(first_block->block_id);
+              if (items_being_processed_iter != peer->ids_of_items_being_processed.end())
               {
-                auto items_being_processed_iter = peer->ids_of_items_being_processed.find(received_block_iter->block_id);
-                if (items_being_processed_iter != peer->ids_of_items_being_processed.end())
+                peer->ids_of_items_being_processed.erase(items_being_processed_iter);
+                dlog("Removed item from ${endpoint}'s list of items being processed, still processing ${len} blocks",
+                     ("endpoint", peer->get_remote_endpoint())("len", peer->ids_of_items_being_processed.size()));
+
+                // if we just processed the last item in our list from this peer, we will want to
+                // send another request to find out if we are now in sync (this is normally handled in
+                // send_sync_block_to_node_delegate)
+                if (peer->ids_of_items_to_get.empty() &&
+                    peer->number_of_unfetched_item_ids == 0 &&
+                    peer->ids_of_items_being_processed.empty())
                 {
-                  peer->ids_of_items_being_processed.erase(items_being_processed_iter);
-                  dlog("Removed item from ${endpoint}'s list of items being processed, still processing ${len} blocks",
-                       ("endpoint", peer->get_remote_endpoint())("len", peer->ids_of_items_being_processed.size()));
-
-                  // if we just processed the last item in our list from this peer, we will want to
-                  // send another request to find out if we are now in sync (this is normally handled in
-                  // send_sync_block_to_node_delegate)
-                  if (peer->ids_of_items_to_get.empty() &&
-                      peer->number_of_unfetched_item_ids == 0 &&
-                      peer->ids_of_items_being_processed.empty())
-                  {
-                    dlog("We received last item in our list for peer ${endpoint}, setup to do a sync check", ("endpoint", peer->get_remote_endpoint()));
-                    peers_needing_next_batch.push_back( peer );
-                  }
+                  dlog("We received last item in our list for peer ${endpoint}, setup to do a sync check", ("endpoint", peer->get_remote_endpoint()));
+                  peers_needing_next_batch.push_back( peer );
                 }
               }
-              for( const peer_connection_ptr& peer : peers_needing_next_batch )
-                fetch_next_batch_of_item_ids_from_peer(peer.get());
             }
-
-            break; // start iterating _received_sync_items from the beginning
-          } // end if potential_first_block
-        } // end for each block in _received_sync_items
+            for( const peer_connection_ptr& peer : peers_needing_next_batch )
+              fetch_next_batch_of_item_ids_from_peer(peer.get());
+            block_processed_this_iteration = true;
+          }
+        }
 
         if (_handle_message_calls_in_progress.size() >= _max_blocks_to_handle_at_once)
         {
@@ -3274,6 +3337,14 @@ namespace graphene { namespace net { namespace detail {
 
       dlog("leaving process_backlog_of_sync_blocks, ${count} processed", ("count", blocks_processed));
 
+      // more sync blocks would only be dropped again until the client has taken some from the full buffer
+      if (_received_sync_items.full())
+      {
+        dlog("suspending fetching sync blocks because the backlog of ${count} blocks is full",
+             ("count", _received_sync_items.size()));
+        _suspend_fetching_sync_blocks = true;
+      }
+
       if (!_suspend_fetching_sync_blocks)
         trigger_fetch_sync_items_loop();
     }
@@ -3293,9 +3364,11 @@ namespace graphene { namespace net { namespace detail {
       VERIFY_CORRECT_THREAD();
       dlog( "received a sync block from peer ${endpoint}", ("endpoint", originating_peer->get_remote_endpoint() ) );
 
-      // add it to the front of _received_sync_items, then process _received_sync_items to try to
+      // add it to _received_sync_items, then process _received_sync_items to try to
       // pass as many messages as possible to the client.
-      _new_received_sync_items.push_front( block_message_to_process );
+      if( !_received_sync_items.add( block_message_to_process ) )
+        dlog( "sync block ${id} was not buffered, either it is already there or the buffer is full",
+              ("id", block_message_to_process.block_id) );
       trigger_process_backlog_of_sync_blocks();
     }
 
@@ -3494,8 +3567,15 @@ namespace graphene { namespace net { namespace detail {
           try
           {
             originating_peer->last_sync_item_received_time = fc::time_point::now();
-            _active_sync_requests.erase(block_message_to_process.block_id);
-            process_block_during_syncing(originating_peer, block_message_to_process, message_hash);
+            originating_peer->sync_throughput.block_received( originating_peer->last_sync_item_received_time );
+            // if the block was requested from two peers, only the copy which arrives first is processed
+            const bool late_copy = ( _active_sync_requests.erase(block_message_to_process.block_id) == 0 &&
+                                     _reassigned_sync_requests.erase(block_message_to_process.block_id) > 0 );
+            if (late_copy)
+              dlog("ignoring sync block ${id} from ${endpoint}, it has already been received from another peer",
+                   ("id", block_message_to_process.block_id)("endpoint", originating_peer->get_remote_endpoint()));
+            else
+              process_block_during_syncing(originating_peer, block_message_to_process, message_hash);
             if (originating_peer->idle())
             {
               // we have finished fetching a batch of items, so we either need to grab another batch of items
@@ -3506,6 +3586,8 @@ namespace graphene { namespace net { namespace detail {
               else
                 trigger_fetch_sync_items_loop();
             }
+            else if (originating_peer->sync_items_requested_from_peer.size() * 2 <= get_sync_window(*originating_peer))
+              trigger_fetch_sync_items_loop(); // keep the requests to this peer flowing
             return;
           }
           catch (const fc::canceled_exception& e)
@@ -4658,8 +4740,9 @@ namespace graphene { namespace net { namespace detail {
       }
       ilog( "--------- MEMORY USAGE ------------" );
       ilog( "node._active_sync_requests size: ${size}", ("size", _active_sync_requests.size() ) );
-      ilog( "node._received_sync_items size: ${size}", ("size", _received_sync_items.size() ) );
-      ilog( "node._new_received_sync_items size: ${size}", ("size", _new_received_sync_items.size() ) );
+      ilog( "node._received_sync_items size: ${size}, ${bytes} bytes, ${dropped} dropped",
+            ("size", _received_sync_items.size())("bytes", _received_sync_items.packed_size())
+            ("dropped", _received_sync_items.dropped_blocks()) );
       ilog( "node._items_to_fetch size: ${size}", ("size", _items_to_fetch.size() ) );
       ilog( "node._new_inventory size: ${size}", ("size", _new_inventory.size() ) );
       ilog( "node._message_cache size: ${size}", ("size", _message_cache.size() ) );
@@ -4837,6 +4920,14 @@ namespace graphene { namespace net { namespace detail {
         peer_details["peer_needs_sync_items_from_us"] = peer->peer_needs_sync_items_from_us;
         peer_details["we_need_sync_items_from_peer"] = peer->we_need_sync_items_from_peer;
 
+        // sync statistics
+        peer_details["sync_blocks_received"] = peer->sync_throughput.blocks_received;
+        peer_details["sync_blocks_per_second"] = peer->sync_throughput.blocks_per_second;
+        peer_details["sync_latency_ms"] = peer->sync_throughput.latency.count() / 1000;
+        peer_details["sync_window"] = get_sync_window(*peer);
+        peer_details["sync_requests_in_flight"] = peer->sync_items_requested_from_peer.size();
+        peer_details["sync_reassigned_requests"] = peer->sync_throughput.reassigned_requests;
+
         this_peer_status.info = peer_details;
         statuses.push_back(this_peer_status);
       }
@@ -4922,6 +5013,8 @@ namespace graphene { namespace net { namespace detail {
         _max_sync_blocks_to_prefetch = params["max_sync_blocks_to_prefetch"].as<uint32_t>(1);
       if (params.contains("max_sync_blocks_per_peer"))
         _max_sync_blocks_per_peer = params["max_sync_blocks_per_peer"].as<uint32_t>(1);
+      if (params.contains("min_sync_blocks_per_peer"))
+        _min_sync_blocks_per_peer = params["min_sync_blocks_per_peer"].as<uint32_t>(1);
 
       _desired_number_of_connections = std::min(_desired_number_of_connections, _maximum_number_of_connections);
 
@@ -4942,6 +5035,7 @@ namespace graphene { namespace net { namespace detail {
       result["max_blocks_to_handle_at_once"] = _max_blocks_to_handle_at_once;
       result["max_sync_blocks_to_prefetch"] = _max_sync_blocks_to_prefetch;
       result["max_sync_blocks_per_peer"] = _max_sync_blocks_per_peer;
+      result["min_sync_blocks_per_peer"] = _min_sync_blocks_per_peer;
       return result;
     }
 
@@ -5240,6 +5334,8 @@ namespace graphene { namespace net { namespace detail {
       _node_delegate(delegate),
       _thread(thread_for_delegate_calls)
       BOOST_PP_SEQ_FOR_EACH(INITIALIZE_ACCUMULATOR, unused, NODE_DELEGATE_METHOD_NAMES)
+      , _transaction_handoff(std::make_shared<transaction_handoff>(delegate))
+      , _known_items_filter(delegate->get_known_items_filter())
     {}
 #undef INITIALIZE_ACCUMULATOR
 
@@ -5331,6 +5427,12 @@ namespace graphene { namespace net { namespace detail {
 
     bool statistics_gathering_node_delegate_wrapper::has_item( const net::item_id& id )
     {
+      if( _known_items_filter )
+      {
+        const auto result = _known_items_filter->lookup( id );
+        if( result != known_items_filter::lookup_result::maybe )
+          return result == known_items_filter::lookup_result::known;
+      }
       INVOKE_AND_COLLECT_STATISTICS(has_item, id);
     }
 
@@ -5347,7 +5449,68 @@ namespace graphene { namespace net { namespace detail {
 
     void statistics_gathering_node_delegate_wrapper::handle_transaction( const graphene::net::trx_message& transaction_message )
     {
-      INVOKE_AND_COLLECT_STATISTICS(handle_transaction, transaction_message);
+      if( _thread->is_current() )
+      {
+        INVOKE_AND_COLLECT_STATISTICS(handle_transaction, transaction_message);
+      }
+
+      std::shared_ptr<call_statistics_collector> collector = std::make_shared<call_statistics_collector>(
+                                                     "handle_transaction",
+                                                     &_handle_transaction_execution_accumulator,
+                                                     &_handle_transaction_delay_before_accumulator,
+                                                     &_handle_transaction_delay_after_accumulator);
+      fc::promise<void>::ptr done = fc::promise<void>::create( "handle_transaction" );
+      queued_transaction queued { transaction_message, done, collector };
+      if( !_transaction_handoff->queue.try_push( std::move(queued) ) )
+      {
+        // the queue is full, hand the transaction over on its own
+        _thread->async( [&, collector](){
+          call_statistics_collector::actual_execution_measurement_helper helper(collector);
+          _node_delegate->handle_transaction(transaction_message);
+        }, "invoke handle_transaction" ).wait();
+        return;
+      }
+
+      // Only schedule a task if none is pending, the pending one will pick up this transaction too
+      if( !_transaction_handoff->drain_scheduled.exchange( true ) )
+      {
+        std::shared_ptr<transaction_handoff> handoff = _transaction_handoff;
+        _thread->async( [handoff](){ handoff->drain(); }, "handle queued transactions" );
+      }
+      fc::future<void>( done ).wait();
+    }
+
+    void statistics_gathering_node_delegate_wrapper::transaction_handoff::drain()
+    {
+      // Clear the flag before looking at the queue, so that a transaction queued after the queue is found empty
+      // schedules another task
+      drain_scheduled.store( false );
+      queued_transaction queued;
+      while( queue.try_pop( queued ) )
+      {
+        try
+        {
+          call_statistics_collector::actual_execution_measurement_helper helper( queued.statistics_collector );
+          delegate->handle_transaction( queued.message );
+          queued.done->set_value();
+        }
+        catch( const fc::exception& e )
+        {
+          queued.done->set_exception( e.dynamic_copy_exception() );
+        }
+        catch( const std::exception& e )
+        {
+          queued.done->set_exception( std::make_shared<fc::std_exception_wrapper>(
+                                            fc::std_exception_wrapper::from_current_exception( e ) ) );
+        }
+        catch( ... )
+        {
+          queued.done->set_exception( std::make_shared<fc::unhandled_exception>(
+                FC_LOG_MESSAGE( warn, "unrecognized exception while handling a transaction" ),
+                std::current_exception() ) );
+        }
+        queued = queued_transaction();
+      }
     }
 
     std::vector<item_hash_t> statistics_gathering_node_delegate_wrapper::get_block_ids(const std::vector<item_hash_t>& blockchain_synopsis,
@@ -39,7 +39,9 @@
 #define testnetlog(...) do {} while (0)
 #endif
 
+#include <atomic>
 #include <memory>
+#include <unordered_set>
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics.hpp>
 #include <boost/accumulators/statistics/rolling_mean.hpp>
@@ -54,6 +56,8 @@
 #include <graphene/net/node.hpp>
 #include <graphene/net/core_messages.hpp>
 #include <graphene/net/peer_connection.hpp>
+#include <graphene/net/ring_buffer.hpp>
+#include <graphene/net/sync_block_buffer.hpp>
 
 namespace graphene { namespace net { namespace detail {
 
@@ -361,6 +365,37 @@ class statistics_gathering_node_delegate_wrapper : public node_delegate
           _execution_completed_time = fc::time_point::now();
         }
       };
+
+      /// A transaction waiting to be handled by the delegate thread
+      struct queued_transaction
+      {
+        trx_message                                 message;
+        fc::promise<void>::ptr                      done;
+        std::shared_ptr<call_statistics_collector>  statistics_collector;
+      };
+
+      /**
+       * Transactions are handed over to the delegate thread through a lock-free queue, and all transactions queued
+       * by the time the delegate thread gets to them are handled in one task, instead of one task per transaction.
+       * This is shared with the tasks, so that it outlives the wrapper while they are scheduled.
+       */
+      struct transaction_handoff
+      {
+        explicit transaction_handoff( std::shared_ptr<node_delegate> delegate_to_call )
+          : delegate( std::move(delegate_to_call) ) {}
+
+        /// Handle all queued transactions, called on the delegate thread
+        void drain();
+
+        std::shared_ptr<node_delegate>   delegate;
+        ring_buffer<queued_transaction>  queue { 1024 };
+        std::atomic<bool>                drain_scheduled { false };
+      };
+      std::shared_ptr<transaction_handoff> _transaction_handoff;
+
+      /// Items known to the delegate, maintained by the delegate, so that has_item does not need to call the
+      /// delegate thread for them, may be null
+      std::shared_ptr<const known_items_filter> _known_items_filter;
    public:
       statistics_gathering_node_delegate_wrapper(std::shared_ptr<node_delegate> delegate,
                                                  fc::thread* thread_for_delegate_calls);
@@ -459,11 +494,12 @@ public:
 
       /// List of sync blocks we've asked for from peers but have not yet received
       active_sync_requests_map              _active_sync_requests;
-      /// List of sync blocks we've just received but haven't yet tried to process
-      std::list<graphene::net::block_message> _new_received_sync_items;
-      /// List of sync blocks we've received, but can't yet process because we are still missing blocks
+      /// Sync blocks which have been requested from a second peer because the first one was too slow,
+      /// until both requests are settled
+      std::unordered_set<graphene::net::block_id_type> _reassigned_sync_requests;
+      /// Sync blocks we've received, but can't yet process because we are still missing blocks
       /// that come earlier in the chain
-      std::list<graphene::net::block_message> _received_sync_items;
+      sync_block_buffer                     _received_sync_items;
       /// @}
 
       fc::future<void> _process_backlog_of_sync_blocks_done;
@@ -624,6 +660,8 @@ public:
       size_t _max_sync_blocks_to_prefetch = MAX_SYNC_BLOCKS_TO_PREFETCH;
       /// Maximum number of blocks per peer during syncing
       size_t _max_sync_blocks_per_peer = GRAPHENE_NET_MAX_BLOCKS_PER_PEER_DURING_SYNCING;
+      /// Minimum number of blocks per peer during syncing, see @ref sync_throughput_meter::window
+      size_t _min_sync_blocks_per_peer = GRAPHENE_NET_MIN_BLOCKS_PER_PEER_DURING_SYNCING;
 
       std::list<fc::future<void> > _handle_message_calls_in_progress;
 
@@ -644,6 +682,10 @@ public:
       void trigger_p2p_network_connect_loop();
 
       bool have_already_received_sync_item( const item_hash_t& item_hash );
+      /// @return the number of sync blocks to keep requested from the peer
+      size_t get_sync_window( const peer_connection& peer ) const;
+      /// Forget a sync request to a peer which will not deliver the block
+      void cancel_sync_request( const item_hash_t& item_hash );
       void request_sync_item_from_peer( const peer_connection_ptr& peer, const item_hash_t& item_to_request );
       void request_sync_items_from_peer( const peer_connection_ptr& peer, const std::vector<item_hash_t>& items_to_request );
       void fetch_sync_items_loop();
@@ -31,6 +31,8 @@
 
 #include <boost/scope_exit.hpp>
 
+#include <cmath>
+
 #ifdef DEFAULT_LOGGER
 # undef DEFAULT_LOGGER
 #endif
@@ -560,4 +562,43 @@ namespace graphene { namespace net
       return remote_inbound_endpoint;
     }
 
+    void sync_throughput_meter::requests_sent( const fc::time_point& now )
+    {
+      _requests_sent_time = now;
+      _waiting_for_first_block = true;
+    }
+
+    void sync_throughput_meter::block_received( const fc::time_point& now )
+    {
+      constexpr double latency_weight = 0.2;
+      constexpr double rate_weight = 0.1;
+      ++blocks_received;
+      if( _waiting_for_first_block )
+      {
+        _waiting_for_first_block = false;
+        const fc::microseconds sample = now - _requests_sent_time;
+        latency = ( blocks_received == 1 ) ? sample
+                  : fc::microseconds( int64_t( latency.count() * ( 1 - latency_weight )
+                                               + sample.count() * latency_weight ) );
+      }
+      else
+      {
+        // blocks which arrive at the same time are averaged with the following ones
+        const double seconds = std::max( ( now - _last_block_time ).count(), int64_t(1000) ) / 1000000.0;
+        const double sample = 1 / seconds;
+        blocks_per_second = ( blocks_per_second <= 0 ) ? sample
+                            : blocks_per_second * ( 1 - rate_weight ) + sample * rate_weight;
+      }
+      _last_block_time = now;
+    }
+
+    uint32_t sync_throughput_meter::window( uint32_t min_window, uint32_t max_window )const
+    {
+      if( !is_measured() || blocks_per_second <= 0 )
+        return max_window;
+      const double seconds = latency.count() / 1000000.0 + 1;
+      const double blocks = std::ceil( blocks_per_second * seconds );
+      return uint32_t( std::max( double(min_window), std::min( double(max_window), blocks ) ) );
+    }
+
 } } // end namespace graphene::net
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <graphene/net/sync_block_buffer.hpp>
+
+namespace graphene { namespace net {
+
+bool sync_block_buffer::add( const block_message& block )
+{
+   auto& id_idx = _blocks.get<by_id>();
+   if( id_idx.find( block.block_id ) != id_idx.end() )
+      return false;
+
+   entry_type entry;
+   entry.id = block.block_id;
+   entry.num = block_header::num_from_id( block.block_id );
+   entry.packed_size = fc::raw::pack_size( block.block );
+   entry.block = block;
+   const uint64_t entry_size = entry.packed_size;
+   if( !id_idx.insert( std::move(entry) ).second )
+      return false;
+   _packed_size += entry_size;
+   enforce_max_size();
+   return contains( block.block_id );
+}
+
+bool sync_block_buffer::contains( const block_id_type& id )const
+{
+   const auto& id_idx = _blocks.get<by_id>();
+   return id_idx.find( id ) != id_idx.end();
+}
+
+fc::optional<block_message> sync_block_buffer::take( const block_id_type& id )
+{
+   auto& id_idx = _blocks.get<by_id>();
+   auto itr = id_idx.find( id );
+   if( itr == id_idx.end() )
+      return {};
+   // The block is not part of any key, so it can be moved out before the entry is erased
+   fc::optional<block_message> result( std::move( const_cast<entry_type&>( *itr ).block ) );
+   _packed_size -= itr->packed_size;
+   id_idx.erase( itr );
+   return result;
+}
+
+void sync_block_buffer::remove( const block_id_type& id )
+{
+   auto& id_idx = _blocks.get<by_id>();
+   auto itr = id_idx.find( id );
+   if( itr == id_idx.end() )
+      return;
+   _packed_size -= itr->packed_size;
+   id_idx.erase( itr );
+}
+
+void sync_block_buffer::set_max_size( uint64_t bytes )
+{
+   _max_size = bytes;
+   enforce_max_size();
+}
+
+void sync_block_buffer::clear()
+{
+   _blocks.clear();
+   _packed_size = 0;
+}
+
+void sync_block_buffer::enforce_max_size()
+{
+   auto& num_idx = _blocks.get<by_num>();
+   while( _packed_size > _max_size && !num_idx.empty() )
+   {
+      auto itr = std::prev( num_idx.end() );
+      _packed_size -= itr->packed_size;
+      num_idx.erase( itr );
+      ++_dropped_blocks;
+   }
+}
+
+} } // graphene::net
@@ -71,7 +71,7 @@ struct custom_op_visitor
 void custom_operations_plugin_impl::onBlock()
 {
    graphene::chain::database& db = database();
-   const vector<optional< operation_history_object > >& hist = db.get_applied_operations();
+   const applied_operation_log& hist = db.get_applied_operations();
    for( const optional< operation_history_object >& o_operation : hist )
    {
       if(!o_operation.valid() || !o_operation->op.is_type<custom_operation>())
@@ -123,7 +123,7 @@ void elasticsearch_plugin_impl::update_account_histories( const signed_block& b
    index_name = generateIndexName(b.timestamp, _options.index_prefix);
 
    graphene::chain::database& db = database();
-   const vector<optional< operation_history_object > >& hist = db.get_applied_operations();
+   const applied_operation_log& hist = db.get_applied_operations();
    bool is_first = true;
    auto skip_oho_id = [&is_first,&db,this]() {
       if( is_first && db._undo_db.enabled() ) // this ensures that the current id is rolled back on undo
@@ -46,6 +46,98 @@ class grouped_orders_plugin_impl
       flat_set<uint16_t>         _tracked_groups;
 };
 
+/**
+ *  @brief Prefix sums of the amounts for sale in the order groups of one group width in one market.
+ *
+ *  The groups which existed at the last rebuild are kept in the same order as in the group map, i.e. from the best
+ *  price to the worst, and their amounts are stored in a Fenwick tree. Changing the amount of one of them, including
+ *  removing it which leaves an empty slot, updates the tree in O(log n). Groups created since the last rebuild are
+ *  kept in a small ordered map next to the tree. The cumulative amount down to any price is the prefix sum of the
+ *  tree plus the amounts of the new groups above that price. The layout is compacted by a rebuild at most once per
+ *  block, see @ref limit_order_group_index::compact_prefix_sums.
+ */
+struct limit_order_group_prefix_sums
+{
+   vector<price>      min_prices; ///< descending
+   vector<share_type> tree;       ///< 1-based Fenwick tree over the amounts of the groups in @ref min_prices
+   /// Amounts of the groups created since the last rebuild, by min_price in descending order
+   map<price, share_type, std::greater<price>> new_groups;
+   /// Whether groups have been created or removed since the last rebuild
+   bool               stale = false;
+
+   template<typename Iterator>
+   void rebuild( Iterator begin, Iterator end )
+   {
+      min_prices.clear();
+      tree.assign( 1, 0 );
+      for( auto itr = begin; itr != end; ++itr )
+      {
+         min_prices.push_back( itr->first.min_price );
+         tree.push_back( itr->second.total_for_sale );
+      }
+      const size_t n = min_prices.size();
+      for( size_t i = 1; i <= n; ++i )
+      {
+         size_t parent = i + ( i & ( 0 - i ) );
+         if( parent <= n )
+            tree[parent] += tree[i];
+      }
+      new_groups.clear();
+      stale = false;
+   }
+
+   /// @return the number of groups in the tree whose min_price is greater than or equal to @p p
+   size_t count_not_below( const price& p )const
+   {
+      return std::partition_point( min_prices.begin(), min_prices.end(),
+                                   [&p]( const price& min_price ) { return min_price >= p; } ) - min_prices.begin();
+   }
+
+   /// @return the total amount for sale in the groups whose min_price is greater than or equal to @p p
+   share_type cumulative_for_sale( const price& p )const
+   {
+      share_type result = 0;
+      for( size_t i = count_not_below( p ); i > 0; i -= ( i & ( 0 - i ) ) )
+         result += tree[i];
+      for( auto itr = new_groups.begin(); itr != new_groups.end() && itr->first >= p; ++itr )
+         result += itr->second;
+      return result;
+   }
+
+   void add( const price& min_price, share_type delta )
+   {
+      const size_t pos = count_not_below( min_price );
+      if( pos > 0 && min_prices[pos - 1] == min_price )
+      {
+         for( size_t i = pos; i < tree.size(); i += ( i & ( 0 - i ) ) )
+            tree[i] += delta;
+         return;
+      }
+      auto itr = new_groups.emplace( min_price, 0 ).first;
+      itr->second += delta;
+      if( itr->second == 0 )
+         new_groups.erase( itr );
+   }
+};
+
+struct limit_order_group_market
+{
+   uint16_t      group = 0;
+   asset_id_type base;
+   asset_id_type quote;
+
+   limit_order_group_market( uint16_t g, const price& p )
+   : group( g ), base( p.base.asset_id ), quote( p.quote.asset_id ) {}
+
+   limit_order_group_key first_key()const { return limit_order_group_key( group, price::max( base, quote ) ); }
+   limit_order_group_key last_key()const { return limit_order_group_key( group, price::min( base, quote ) ); }
+
+   friend bool operator < ( const limit_order_group_market& a, const limit_order_group_market& b )
+   {
+      return std::tie( a.group, a.base, a.quote ) < std::tie( b.group, b.base, b.quote );
+   }
+};
+
 /**
  *  @brief This secondary index is used to track changes on limit order objects.
  */
@@ -65,16 +157,60 @@ class limit_order_group_index : public secondary_index
       const map< limit_order_group_key, limit_order_group_data >& get_order_groups() const
       { return _og_data; }
 
+      share_type get_cumulative_for_sale( uint16_t group, const price& p ) const;
+
+      /// Rebuild the prefix sums of the markets in which groups have been created or removed, called once per block
+      void compact_prefix_sums();
+
    private:
       void remove_order( const limit_order_object& obj, bool remove_empty = true );
 
+      /// Called after the amount of a group is changed, @p layout_changed if the group is created or removed
+      void update_prefix_sums( uint16_t group, const price& min_price, share_type delta, bool layout_changed );
+
       /** tracked groups */
       flat_set<uint16_t> _tracked_groups;
 
       /** maps the group key to group data */
       map< limit_order_group_key, limit_order_group_data > _og_data;
+
+      /** prefix sums of the order groups per group width and market, built on demand */
+      mutable map< limit_order_group_market, limit_order_group_prefix_sums > _prefix_sums;
 };
 
+void limit_order_group_index::update_prefix_sums( uint16_t group, const price& min_price, share_type delta,
+                                                  bool layout_changed )
+{
+   auto itr = _prefix_sums.find( limit_order_group_market( group, min_price ) );
+   if( itr == _prefix_sums.end() )
+      return;
+   itr->second.add( min_price, delta );
+   if( layout_changed )
+      itr->second.stale = true;
+}
+
+void limit_order_group_index::compact_prefix_sums()
+{
+   for( auto& item : _prefix_sums )
+   {
+      if( item.second.stale )
+         item.second.rebuild( _og_data.lower_bound( item.first.first_key() ),
+                              _og_data.upper_bound( item.first.last_key() ) );
+   }
+}
+
+share_type limit_order_group_index::get_cumulative_for_sale( uint16_t group, const price& p ) const
+{
+   const limit_order_group_market market( group, p );
+   auto itr = _prefix_sums.find( market );
+   if( itr == _prefix_sums.end() )
+   {
+      itr = _prefix_sums.emplace( market, limit_order_group_prefix_sums() ).first;
+      itr->second.rebuild( _og_data.lower_bound( market.first_key() ), _og_data.upper_bound( market.last_key() ) );
+   }
+   return itr->second.cumulative_for_sale( p );
+}
+
 void limit_order_group_index::object_inserted( const object& objct )
 { try {
    const limit_order_object& o = static_cast<const limit_order_object&>( objct );
@@ -85,6 +221,7 @@ void limit_order_group_index::object_inserted( const object& objct )
    {
       auto create_ogo = [&]() {
          idx[ limit_order_group_key( group, o.sell_price ) ] = limit_order_group_data( o.sell_price, o.for_sale );
+         update_prefix_sums( group, o.sell_price, o.for_sale, true );
       };
       // if idx is empty, insert this order
       // Note: not capped
@@ -135,14 +272,17 @@ void limit_order_group_index::object_inserted( const object& objct )
             {  // need to update itr->min_price here, if itr is below min, and new order is even lower
                // TODO improve performance
                limit_order_group_data data( itr->second.max_price, o.for_sale + itr->second.total_for_sale );
+               update_prefix_sums( group, itr->first.min_price, -itr->second.total_for_sale, true );
                idx.erase( itr );
                idx[ limit_order_group_key( group, o.sell_price ) ] = data;
+               update_prefix_sums( group, o.sell_price, data.total_for_sale, true );
             }
             else
             {
                if( update_max || ( capped_max && o.sell_price > itr->second.max_price ) )
                   itr->second.max_price = o.sell_price; // store real price here, not capped
                itr->second.total_for_sale += o.for_sale;
+               update_prefix_sums( group, itr->first.min_price, o.for_sale, false );
             }
          }
       }
@@ -172,13 +312,16 @@ void limit_order_group_index::object_inserted( const object& objct )
                   if( o.sell_price > itr->second.max_price )
                      itr->second.max_price = o.sell_price;
                   itr->second.total_for_sale += o.for_sale;
+                  update_prefix_sums( group, itr->first.min_price, o.for_sale, false );
                }
                else
                {  // new order is within the range
                   // TODO improve performance
                   limit_order_group_data data( itr->second.max_price, o.for_sale + itr->second.total_for_sale );
+                  update_prefix_sums( group, itr->first.min_price, -itr->second.total_for_sale, true );
                   idx.erase( itr );
                   idx[ limit_order_group_key( group, o.sell_price ) ] = data;
+                  update_prefix_sums( group, o.sell_price, data.total_for_sale, true );
                }
             }
          }
@@ -226,10 +369,16 @@ void limit_order_group_index::remove_order( const limit_order_object& o, bool re
             // should not happen
             wlog( "can not find the order group containing order for removing (amount dismatch): ${o}", ("o",o) );
          else if( !remove_empty || itr->second.total_for_sale > o.for_sale )
+         {
             itr->second.total_for_sale -= o.for_sale;
+            update_prefix_sums( group, itr->first.min_price, -o.for_sale, false );
+         }
          else
+         {
             // it's the only order in the group and need to be removed
+            update_prefix_sums( group, itr->first.min_price, -itr->second.total_for_sale, true );
             idx.erase( itr );
+         }
       }
    }
 }
@@ -283,6 +432,7 @@ void grouped_orders_plugin::plugin_startup()
                                                    detail::limit_order_group_index >( my->_tracked_groups );
    for( const auto& order : database().get_index_type< limit_order_index >().indices() )
       groups.object_inserted( order );
+   database().applied_block.connect( [&groups]( const signed_block& ) { groups.compact_prefix_sums(); } );
 }
 
 const flat_set<uint16_t>& grouped_orders_plugin::tracked_groups() const
@@ -298,4 +448,12 @@ const map< limit_order_group_key, limit_order_group_data >& grouped_orders_plugi
    return logidx.get_order_groups();
 }
 
+share_type grouped_orders_plugin::cumulative_for_sale( uint16_t group, const price& p )
+{
+   const auto& idx = database().get_index_type< limit_order_index >();
+   const auto& pidx = dynamic_cast<const primary_index< limit_order_index >&>(idx);
+   const auto& logidx = pidx.get_secondary_index< detail::limit_order_group_index >();
+   return logidx.get_cumulative_for_sale( group, p );
+}
+
 } }
@@ -84,6 +84,14 @@ class grouped_orders_plugin : public graphene::app::plugin
 
       const map< limit_order_group_key, limit_order_group_data >& limit_order_groups();
 
+      /**
+       *  @return the total amount for sale in the order groups of @p group in the market of @p p whose min_price
+       *          is greater than or equal to @p p, i.e. the depth of the order book down to that price.
+       *  @note The cost is O(log n) in the number of groups of the market, plus the number of groups created in
+       *        the market during the current block.
+       */
+      share_type cumulative_for_sale( uint16_t group, const price& p );
+
    private:
       std::unique_ptr<detail::grouped_orders_plugin_impl> my;
 };
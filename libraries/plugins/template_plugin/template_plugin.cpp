@@ -103,9 +103,11 @@ void template_plugin::plugin_set_program_options(
 
 void template_plugin::plugin_initialize(const boost::program_options::variables_map& options)
 {
-   // connect with group 0 by default to process before some special steps (e.g. snapshot or next_object_id)
-   database().applied_block.connect( 0, [this]( const signed_block& b) {
-      my->on_block(b);
+   // This plugin only reads the applied blocks, so it can process them off the chain thread.
+   // A plugin which needs to access the database should instead connect to database().applied_block
+   // with group 0 to process before some special steps (e.g. snapshot or next_object_id).
+   database().add_read_only_block_observer( [this]( const applied_block_record& record ) {
+      my->on_block( record.block );
    } );
 
    if (options.count("template_plugin") > 0) {
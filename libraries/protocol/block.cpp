@@ -75,10 +75,11 @@ namespace graphene { namespace protocol {
 
       if( 0 == _calculated_merkle_root._hash[0].value() )
       {
+         const block_derived_data& derived_data = get_derived_data();
          vector<digest_type> ids;
          ids.resize( transactions.size() );
          for( uint32_t i = 0; i < transactions.size(); ++i )
-            ids[i] = transactions[i].merkle_digest();
+            ids[i] = derived_data.transactions[i].merkle_digest;
 
          vector<digest_type>::size_type current_number_of_hashes = ids.size();
          while( current_number_of_hashes > 1 )
@@ -98,6 +99,44 @@ namespace graphene { namespace protocol {
       }
       return _calculated_merkle_root;
    }
+
+   uint64_t signed_block::get_packed_size()const
+   {
+      // The packed block is the packed header followed by the packed vector of transactions
+      const signed_block_header& header = *this;
+      uint64_t result = fc::raw::pack_size( header ) + fc::raw::pack_size( fc::unsigned_int( transactions.size() ) );
+      if( transactions.empty() )
+         return result;
+      for( const auto& derived : get_derived_data().transactions )
+         result += derived.processed_size;
+      return result;
+   }
+
+   const block_derived_data& signed_block::get_derived_data()const
+   {
+      if( !_derived_data )
+      {
+         auto data = std::make_shared<block_derived_data>();
+         data->transactions.reserve( transactions.size() );
+         for( const auto& trx : transactions )
+            data->transactions.push_back( trx.calculate_derived_data() );
+         _derived_data = std::move( data );
+      }
+      FC_ASSERT( _derived_data->transactions.size() == transactions.size(),
+                 "The transactions of the block have been modified without clearing the derived data" );
+      return *_derived_data;
+   }
+
+   void signed_block::set_derived_data( std::shared_ptr<const block_derived_data> data )const
+   {
+      _derived_data = std::move( data );
+   }
+
+   void signed_block::clear_derived_data()
+   {
+      _derived_data.reset();
+      _calculated_merkle_root = checksum_type();
+   }
 } }
 
 GRAPHENE_IMPLEMENT_EXTERNAL_SERIALIZATION( graphene::protocol::block_header)
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/protocol/types.hpp>
+
+#include <map>
+#include <tuple>
+
+namespace graphene { namespace protocol {
+
+   /**
+    *  @brief Caches the outcome of checking the active (or, as a fallback, owner) authority of accounts required
+    *         by transactions, see @ref verify_authority
+    *
+    *  The outcome of such a check only depends on the signing keys of the transaction, on the accounts which have
+    *  already been approved when the check starts, and on the authorities of the accounts involved. The cache does
+    *  not know about the latter, so its owner must clear it whenever an account authority changes.
+    */
+   class authority_check_cache
+   {
+      public:
+         struct key_type
+         {
+            account_id_type            account;
+            flat_set<public_key_type>  signers;
+            flat_set<account_id_type>  approved_before;
+            bool                       allow_non_immediate_owner = false;
+            uint32_t                   max_recursion = 0;
+
+            friend bool operator < ( const key_type& a, const key_type& b )
+            {
+               return std::tie( a.account, a.allow_non_immediate_owner, a.max_recursion, a.signers, a.approved_before )
+                    < std::tie( b.account, b.allow_non_immediate_owner, b.max_recursion, b.signers, b.approved_before );
+            }
+         };
+
+         struct entry_type
+         {
+            /// Whether the authority is satisfied
+            bool                       satisfied = false;
+            /// The signing keys used during the check
+            flat_set<public_key_type>  used_signers;
+            /// The accounts approved after the check
+            flat_set<account_id_type>  approved_after;
+         };
+
+         explicit authority_check_cache( size_t max_entries = 10000 ) : _max_entries( max_entries ) {}
+
+         /// @return the cached outcome, or nullptr if there is none
+         const entry_type* find( const key_type& key )const;
+         /// Cache an outcome, the cache is cleared first if it is full
+         void insert( key_type key, entry_type entry );
+         void clear() { _entries.clear(); }
+         size_t size()const { return _entries.size(); }
+
+      private:
+         size_t                          _max_entries;
+         std::map<key_type, entry_type>  _entries;
+   };
+
+} } // graphene::protocol
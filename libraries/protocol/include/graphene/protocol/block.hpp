@@ -61,13 +61,34 @@ namespace graphene { namespace protocol {
       mutable block_id_type       _block_id;
    };
 
+   /// Data derived from the transactions of a block, in the order of the transactions
+   struct block_derived_data
+   {
+      vector<transaction_derived_data> transactions;
+   };
+
    class signed_block : public signed_block_header
    {
    public:
       const checksum_type& calculate_merkle_root()const;
+      /// @return the packed size of the block, calculated from the derived data of the transactions
+      uint64_t get_packed_size()const;
       vector<processed_transaction> transactions;
+
+      /**
+       * @return the data derived from the transactions, calculated on first use unless it has been set with
+       *         @ref set_derived_data, and shared by copies of this block
+       * @note The data describes the transactions at the time it was calculated. Modifying the transactions
+       *       afterwards, e.g. filling in operation results, requires a call to @ref clear_derived_data.
+       */
+      const block_derived_data& get_derived_data()const;
+      /// Set data derived from the transactions, e.g. after calculating it in parallel
+      void set_derived_data( std::shared_ptr<const block_derived_data> data )const;
+      /// Drop the data derived from the transactions and the merkle root calculated from it
+      void clear_derived_data();
    protected:
       mutable checksum_type   _calculated_merkle_root;
+      mutable std::shared_ptr<const block_derived_data> _derived_data;
    };
 
 } } // graphene::protocol
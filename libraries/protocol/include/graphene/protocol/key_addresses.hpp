@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/protocol/address.hpp>
+
+#include <array>
+
+namespace graphene { namespace protocol {
+
+   /**
+    *  The addresses of a public key which can be used in address authorities, i.e. the PTS addresses of the
+    *  uncompressed and compressed key with version 56 and 0, and the graphene address of the key.
+    *  Deriving them takes five SHA-256 and RIPEMD-160 rounds.
+    */
+   using key_addresses = std::array<address,5>;
+
+   /// @return the addresses of @p key, computed without any cache
+   key_addresses derive_key_addresses( const public_key_type& key );
+
+   /**
+    *  @return the addresses of @p key, served from a bounded process-wide cache of recently used keys
+    *  @note Thread safe
+    */
+   key_addresses get_key_addresses( const public_key_type& key );
+
+   /// Set the maximum number of keys kept in the cache of @ref get_key_addresses, 0 disables the cache
+   void set_key_address_cache_capacity( size_t capacity );
+
+} } // graphene::protocol
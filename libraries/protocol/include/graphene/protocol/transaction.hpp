@@ -24,8 +24,11 @@
 #pragma once
 #include <graphene/protocol/operations.hpp>
 
+#include <fc/crypto/ripemd160.hpp>
+
 namespace graphene { namespace protocol {
    struct predicate_result;
+   class authority_check_cache;
 
    using rejected_predicate = static_variant<predicate_result, fc::exception>;
    using rejected_predicate_map = map<custom_authority_id_type, rejected_predicate>;
@@ -174,6 +177,8 @@ namespace graphene { namespace protocol {
        *            required_auths field of custom_operation or not
        * @param max_recursion maximum level of recursion when verifying, since an account
        *            can have another account in active authorities and/or owner authorities
+       * @param cache optional cache of the checks of required active authorities, which must be cleared when
+       *            any account authority changes
        */
       void verify_authority(
               const chain_id_type& chain_id,
@@ -182,7 +187,8 @@ namespace graphene { namespace protocol {
               const custom_authority_lookup& get_custom,
               bool allow_non_immediate_owner,
               bool ignore_custom_operation_required_auths,
-              uint32_t max_recursion = GRAPHENE_MAX_SIG_CHECK_DEPTH )const;
+              uint32_t max_recursion = GRAPHENE_MAX_SIG_CHECK_DEPTH,
+              authority_check_cache* cache = nullptr )const;
 
       /**
        * This is a slower replacement for get_required_signatures()
@@ -264,6 +270,8 @@ namespace graphene { namespace protocol {
     * @param allow_committee whether to allow the special "committee account" to authorize the operations
     * @param active_approvals accounts that approved the operations with their active authories
     * @param owner_approvals accounts that approved the operations with their owner authories
+    * @param cache optional cache of the checks of required active authorities, which must be cleared when
+    *            any account authority changes
     */
    void verify_authority( const vector<operation>& ops, const flat_set<public_key_type>& sigs,
                           const std::function<const authority*(account_id_type)>& get_active,
@@ -274,7 +282,22 @@ namespace graphene { namespace protocol {
                           uint32_t max_recursion = GRAPHENE_MAX_SIG_CHECK_DEPTH,
                           bool allow_committee = false,
                           const flat_set<account_id_type>& active_approvals = flat_set<account_id_type>(),
-                          const flat_set<account_id_type>& owner_approvals = flat_set<account_id_type>() );
+                          const flat_set<account_id_type>& owner_approvals = flat_set<account_id_type>(),
+                          authority_check_cache* cache = nullptr );
+
+   /// Data derived from a packed processed transaction, see @ref processed_transaction::calculate_derived_data
+   struct transaction_derived_data
+   {
+      transaction_id_type id;
+      /// The packed size of the transaction without signatures, see @ref transaction::get_packed_size
+      uint64_t            packed_size = 0;
+      /// The packed size of the processed transaction, i.e. with signatures and operation results
+      uint64_t            processed_size = 0;
+      /// The RIPEMD-160 hash of the packed signed transaction, which is the ID of the p2p message carrying it
+      fc::ripemd160       message_id;
+      /// The leaf of the transaction in the merkle tree of a block, see @ref processed_transaction::merkle_digest
+      digest_type         merkle_digest;
+   };
 
    /**
     *  @brief captures the result of evaluating the operations contained in the transaction
@@ -298,6 +321,12 @@ namespace graphene { namespace protocol {
       vector<operation_result> operation_results;
 
       digest_type merkle_digest()const;
+
+      /**
+       * Calculate the data derived from the packed transaction by packing it only once, and cache the ID and the
+       * packed size in this transaction.
+       */
+      transaction_derived_data calculate_derived_data()const;
    };
 
    /// @} transactions group
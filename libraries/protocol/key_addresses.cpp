@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <graphene/protocol/key_addresses.hpp>
+#include <graphene/protocol/pts_address.hpp>
+
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace graphene { namespace protocol {
+
+key_addresses derive_key_addresses( const public_key_type& key )
+{
+   return {{ address( pts_address( key, false ) ), // version = 56 (default)
+             address( pts_address( key, true ) ),  // version = 56 (default)
+             address( pts_address( key, false, 0 ) ),
+             address( pts_address( key, true, 0 ) ),
+             address( key ) }};
+}
+
+namespace {
+
+   /// A least recently used cache of key addresses
+   class key_address_cache
+   {
+      public:
+         bool find( const public_key_type& key, key_addresses& result )
+         {
+            std::lock_guard<std::mutex> guard( _mutex );
+            auto itr = _entries.find( key );
+            if( itr == _entries.end() )
+               return false;
+            _lru.splice( _lru.begin(), _lru, itr->second );
+            result = itr->second->second;
+            return true;
+         }
+
+         void insert( const public_key_type& key, const key_addresses& addresses )
+         {
+            std::lock_guard<std::mutex> guard( _mutex );
+            if( 0 == _capacity || _entries.find( key ) != _entries.end() )
+               return;
+            _lru.emplace_front( key, addresses );
+            _entries.emplace( key, _lru.begin() );
+            shrink_to( _capacity );
+         }
+
+         void set_capacity( size_t capacity )
+         {
+            std::lock_guard<std::mutex> guard( _mutex );
+            _capacity = capacity;
+            shrink_to( _capacity );
+         }
+
+      private:
+         using entry_list = std::list< std::pair< public_key_type, key_addresses > >;
+
+         void shrink_to( size_t size )
+         {
+            while( _entries.size() > size )
+            {
+               _entries.erase( _lru.back().first );
+               _lru.pop_back();
+            }
+         }
+
+         std::mutex                                                         _mutex;
+         size_t                                                             _capacity = 10000;
+         /// Most recently used first
+         entry_list                                                         _lru;
+         std::map< public_key_type, entry_list::iterator, pubkey_comparator > _entries;
+   };
+
+   key_address_cache& get_cache()
+   {
+      static key_address_cache cache;
+      return cache;
+   }
+
+}
+
+key_addresses get_key_addresses( const public_key_type& key )
+{
+   key_addresses result;
+   if( get_cache().find( key, result ) )
+      return result;
+   result = derive_key_addresses( key );
+   get_cache().insert( key, result );
+   return result;
+}
+
+void set_key_address_cache_capacity( size_t capacity )
+{
+   get_cache().set_capacity( capacity );
+}
+
+} } // graphene::protocol
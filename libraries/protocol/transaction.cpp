@@ -23,10 +23,11 @@
  */
 
 #include <graphene/protocol/transaction.hpp>
+#include <graphene/protocol/authority_check_cache.hpp>
 #include <graphene/protocol/block.hpp>
 #include <graphene/protocol/exceptions.hpp>
 #include <graphene/protocol/fee_schedule.hpp>
-#include <graphene/protocol/pts_address.hpp>
+#include <graphene/protocol/key_addresses.hpp>
 #include <graphene/protocol/restriction_predicate.hpp>
 
 #include <fc/io/raw.hpp>
@@ -40,6 +41,32 @@ digest_type processed_transaction::merkle_digest()const
    return enc.result();
 }
 
+transaction_derived_data processed_transaction::calculate_derived_data()const
+{
+   // The packed processed transaction starts with the packed signed transaction, which starts with the packed
+   // unsigned transaction
+   const transaction& trx = *this;
+   const size_t transaction_size = fc::raw::pack_size( trx );
+   const size_t signed_transaction_size = transaction_size + fc::raw::pack_size( signatures );
+   std::vector<char> data( signed_transaction_size + fc::raw::pack_size( operation_results ) );
+   fc::datastream<char*> ds( data.data(), data.size() );
+   fc::raw::pack( ds, trx );
+   fc::raw::pack( ds, signatures );
+   fc::raw::pack( ds, operation_results );
+
+   transaction_derived_data result;
+   const digest_type digest = digest_type::hash( data.data(), static_cast<uint32_t>( transaction_size ) );
+   memcpy( result.id._hash, digest._hash, std::min( sizeof(result.id), sizeof(digest) ) );
+   result.packed_size = transaction_size;
+   result.processed_size = data.size();
+   result.message_id = fc::ripemd160::hash( data.data(), static_cast<uint32_t>( signed_transaction_size ) );
+   result.merkle_digest = digest_type::hash( data.data(), static_cast<uint32_t>( data.size() ) );
+
+   _tx_id_buffer = result.id;
+   _packed_size = result.packed_size;
+   return result;
+}
+
 digest_type transaction::digest()const
 {
    digest_type::encoder enc;
@@ -140,18 +167,12 @@ struct sign_state
             available_address_sigs = std::map<address,public_key_type>();
             provided_address_sigs = std::map<address,public_key_type>();
             for( auto& item : available_keys ) {
-             (*available_address_sigs)[ address(pts_address(item, false) ) ] = item; // verison = 56 (default)
-             (*available_address_sigs)[ address(pts_address(item, true) ) ] = item; // verison = 56 (default)
-             (*available_address_sigs)[ address(pts_address(item, false, 0) ) ] = item;
-             (*available_address_sigs)[ address(pts_address(item, true, 0) ) ] = item;
-             (*available_address_sigs)[ address(item) ] = item;
+               for( const auto& addr : get_key_addresses( item ) )
+                  (*available_address_sigs)[ addr ] = item;
             }
             for( auto& item : provided_signatures ) {
-             (*provided_address_sigs)[ address(pts_address(item.first, false) ) ] = item.first; //verison 56 (default)
-             (*provided_address_sigs)[ address(pts_address(item.first, true) ) ] = item.first; // verison 56 (default)
-             (*provided_address_sigs)[ address(pts_address(item.first, false, 0) ) ] = item.first;
-             (*provided_address_sigs)[ address(pts_address(item.first, true, 0) ) ] = item.first;
-             (*provided_address_sigs)[ address(item.first) ] = item.first;
+               for( const auto& addr : get_key_addresses( item.first ) )
+                  (*provided_address_sigs)[ addr ] = item.first;
             }
          }
          auto itr = provided_address_sigs->find(a);
@@ -225,6 +246,54 @@ struct sign_state
          return total_weight >= auth.weight_threshold;
       }
 
+      /**
+       *  Checks the active authority of a required account with the owner authority as a fallback,
+       *  using and filling the cache if there is one.
+       */
+      bool check_required_active( account_id_type id, authority_check_cache* cache )
+      {
+         if( cache == nullptr )
+            return check_authority( id ) || check_authority( get_owner( id ) );
+
+         authority_check_cache::key_type key;
+         key.account = id;
+         key.signers.reserve( provided_signatures.size() );
+         for( const auto& sig : provided_signatures )
+            key.signers.insert( key.signers.end(), sig.first );
+         key.approved_before = approved_by;
+         key.allow_non_immediate_owner = allow_non_immediate_owner;
+         key.max_recursion = max_recursion;
+
+         const auto* cached = cache->find( key );
+         if( cached != nullptr )
+         {
+            for( const auto& signer : cached->used_signers )
+               provided_signatures[ signer ] = true;
+            approved_by = cached->approved_after;
+            return cached->satisfied;
+         }
+
+         // Track the signatures used by this check only
+         flat_map<public_key_type,bool> used_before;
+         used_before.swap( provided_signatures );
+         for( const auto& sig : used_before )
+            provided_signatures.emplace_hint( provided_signatures.end(), sig.first, false );
+
+         authority_check_cache::entry_type entry;
+         entry.satisfied = check_authority( id ) || check_authority( get_owner( id ) );
+         for( auto& sig : provided_signatures )
+         {
+            if( sig.second )
+               entry.used_signers.insert( entry.used_signers.end(), sig.first );
+            sig.second = sig.second || used_before[ sig.first ];
+         }
+         entry.approved_after = approved_by;
+
+         const bool satisfied = entry.satisfied;
+         cache->insert( std::move( key ), std::move( entry ) );
+         return satisfied;
+      }
+
       bool remove_unused_signatures()
       {
          vector<public_key_type> remove_sigs;
@@ -275,7 +344,8 @@ void verify_authority( const vector<operation>& ops, const flat_set<public_key_t
                        uint32_t max_recursion_depth,
                        bool  allow_committee,
                        const flat_set<account_id_type>& active_aprovals,
-                       const flat_set<account_id_type>& owner_approvals )
+                       const flat_set<account_id_type>& owner_approvals,
+                       authority_check_cache* cache )
 {
    rejected_predicate_map rejected_custom_auths;
    try {
@@ -333,8 +403,7 @@ void verify_authority( const vector<operation>& ops, const flat_set<public_key_t
 
    for( auto id : required_active )
    {
-      GRAPHENE_ASSERT( s.check_authority(id) ||
-                       s.check_authority(get_owner(id)),
+      GRAPHENE_ASSERT( s.check_required_active( id, cache ),
                        tx_missing_active_auth, "Missing Active Authority ${id}",
                        ("id",id)("auth",*get_active(id))("owner",*get_owner(id)) );
    }
@@ -467,11 +536,13 @@ void signed_transaction::verify_authority( const chain_id_type& chain_id,
                                            const custom_authority_lookup& get_custom,
                                            bool allow_non_immediate_owner,
                                            bool ignore_custom_operation_required_auths,
-                                           uint32_t max_recursion )const
+                                           uint32_t max_recursion,
+                                           authority_check_cache* cache )const
 { try {
    graphene::protocol::verify_authority( operations, get_signature_keys( chain_id ), get_active, get_owner,
                                          get_custom, allow_non_immediate_owner,
-                                         ignore_custom_operation_required_auths, max_recursion );
+                                         ignore_custom_operation_required_auths, max_recursion,
+                                         false, flat_set<account_id_type>(), flat_set<account_id_type>(), cache );
 } FC_CAPTURE_AND_RETHROW( (*this) ) }
 
 } } // graphene::protocol
@@ -65,7 +65,7 @@ namespace buf = boost::unit_test::framework;
 
 void clearable_block::clear()
 {
-   _calculated_merkle_root = checksum_type();
+   clear_derived_data();
    _signee = fc::ecc::public_key();
    _block_id = block_id_type();
 }
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "benchmark.hpp"
+
+#include <fc/io/json.hpp>
+#include <fc/log/logger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+namespace {
+std::atomic<uint64_t> heap_allocations { 0 };
+}
+
+// Count heap allocations of the whole performance test binary.
+// The array and nothrow forms forward to these by default.
+void* operator new( std::size_t size )
+{
+   heap_allocations.fetch_add( 1, std::memory_order_relaxed );
+   void* p = std::malloc( size > 0 ? size : 1 );
+   if( p == nullptr )
+      throw std::bad_alloc();
+   return p;
+}
+
+void operator delete( void* p ) noexcept
+{
+   std::free( p );
+}
+
+void operator delete( void* p, std::size_t ) noexcept
+{
+   std::free( p );
+}
+
+namespace graphene { namespace chain { namespace test {
+
+uint64_t benchmark_allocation_count()
+{
+   return heap_allocations.load( std::memory_order_relaxed );
+}
+
+uint32_t benchmark_scaled( uint32_t default_value )
+{
+   static const uint64_t scale_percent = []() -> uint64_t {
+      const char* scale_str = getenv( "GRAPHENE_BENCHMARK_SCALE" );
+      return ( scale_str != nullptr ) ? std::stoul( scale_str ) : 100;
+   }();
+   return static_cast<uint32_t>( std::max<uint64_t>( 1, default_value * scale_percent / 100 ) );
+}
+
+uint32_t benchmark_seed()
+{
+   const char* seed_str = getenv( "GRAPHENE_BENCHMARK_SEED" );
+   return ( seed_str != nullptr ) ? static_cast<uint32_t>( std::stoul( seed_str ) ) : 1;
+}
+
+benchmark_recorder::benchmark_recorder( std::string workload ) : _workload( std::move(workload) ) {}
+
+benchmark_recorder& benchmark_recorder::parameter( const std::string& key, const fc::variant& value )
+{
+   _parameters( key, value );
+   return *this;
+}
+
+fc::variant_object benchmark_recorder::summary()const
+{
+   std::vector<int64_t> sorted( _samples );
+   std::sort( sorted.begin(), sorted.end() );
+   const auto percentile_us = [&sorted]( uint32_t percent ) -> double {
+      if( sorted.empty() )
+         return 0;
+      return sorted[ ( sorted.size() - 1 ) * percent / 100 ] / 1000.0;
+   };
+
+   int64_t total_ns = 0;
+   for( const auto sample : sorted )
+      total_ns += sample;
+
+   fc::mutable_variant_object result;
+   result( "workload", _workload )
+         ( "parameters", _parameters )
+         ( "samples", sorted.size() )
+         ( "operations", _operations )
+         ( "total_ms", total_ns / 1000000.0 )
+         ( "ops_per_sec", total_ns > 0 ? _operations * 1e9 / total_ns : 0.0 )
+         ( "p50_us", percentile_us( 50 ) )
+         ( "p99_us", percentile_us( 99 ) )
+         ( "max_us", percentile_us( 100 ) )
+         ( "allocations", _allocations )
+         ( "allocations_per_op", _operations > 0 ? double(_allocations) / _operations : 0.0 );
+   return result;
+}
+
+void benchmark_recorder::report()const
+{
+   const fc::variant_object result = summary();
+   const std::string line = fc::json::to_string( result, fc::json::legacy_generator );
+   wlog( "Benchmark: ${r}", ("r", line) );
+
+   const char* output = getenv( "GRAPHENE_BENCHMARK_OUTPUT" );
+   if( output != nullptr )
+   {
+      std::ofstream out( output, std::ios::app );
+      out << line << '\n';
+   }
+}
+
+} } } // graphene::chain::test
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <fc/variant.hpp>
+#include <fc/variant_object.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace graphene { namespace chain { namespace test {
+
+/// @return the number of heap allocations made by the process so far
+uint64_t benchmark_allocation_count();
+
+/// @return @p default_value scaled by the @c GRAPHENE_BENCHMARK_SCALE environment variable (in percent, default 100),
+///         but at least 1
+uint32_t benchmark_scaled( uint32_t default_value );
+
+/// @return the seed of workload generators, taken from the @c GRAPHENE_BENCHMARK_SEED environment variable
+///         (default 1) so that workloads are reproducible
+uint32_t benchmark_seed();
+
+/**
+ * @brief Collects the samples of one benchmark workload and reports them
+ *
+ * The report contains operations per second, latency percentiles and the number of heap allocations.
+ * It is logged, and if the @c GRAPHENE_BENCHMARK_OUTPUT environment variable is set, it is appended to the file
+ * named by it as one line of JSON, so that results can be compared across releases.
+ */
+class benchmark_recorder
+{
+   public:
+      explicit benchmark_recorder( std::string workload );
+
+      /// Add a parameter of the workload to the report
+      benchmark_recorder& parameter( const std::string& key, const fc::variant& value );
+
+      /// Run @p f once and record it as a sample which covers @p operations operations
+      template<typename Functor>
+      void measure( Functor&& f, uint64_t operations = 1 )
+      {
+         const uint64_t allocations_before = benchmark_allocation_count();
+         const auto start = std::chrono::steady_clock::now();
+         f();
+         const auto end = std::chrono::steady_clock::now();
+         _allocations += benchmark_allocation_count() - allocations_before;
+         _samples.push_back( std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count() );
+         _operations += operations;
+      }
+
+      /// Count operations which were done during samples but were not known when they were measured
+      void add_operations( uint64_t operations ) { _operations += operations; }
+
+      size_t sample_count()const { return _samples.size(); }
+
+      /// @return the summary of all samples recorded so far
+      fc::variant_object summary()const;
+
+      /// Log the summary and append it to the output file if configured
+      void report()const;
+
+   private:
+      std::string                 _workload;
+      fc::mutable_variant_object  _parameters;
+      std::vector<int64_t>        _samples; ///< in nanoseconds
+      uint64_t                    _operations = 0;
+      uint64_t                    _allocations = 0;
+};
+
+} } } // graphene::chain::test
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#pragma once
+
+#include <graphene/chain/hardfork.hpp>
+
+#include "../common/database_fixture.hpp"
+#include "benchmark.hpp"
+
+#include <random>
+
+namespace graphene { namespace chain { namespace test {
+
+/// Number of transactions pushed before a block is generated, small enough to never postpone transactions
+const uint32_t txs_per_block = 500;
+
+/// Pushes transactions and generates blocks with less overhead than the helpers of @ref database_fixture
+struct chain_benchmark_fixture : database_fixture
+{
+   const fc::ecc::private_key block_signing_key = generate_private_key( "null_key" );
+   std::mt19937 rng { benchmark_seed() };
+   uint32_t pending_txs = 0;
+
+   /// Move the chain past all hardforks so that the current code paths are measured
+   void advance_past_hardforks()
+   {
+      generate_blocks( HARDFORK_CORE_2604_TIME );
+      generate_block();
+      trx.clear();
+   }
+
+   /// Generate a block without verifying asset supplies, which would dominate the run time of the benchmarks
+   signed_block produce_block( uint32_t miss_blocks = 0 )
+   {
+      signed_block block = db.generate_block( db.get_slot_time( miss_blocks + 1 ),
+                                              db.get_scheduled_witness( miss_blocks + 1 ),
+                                              block_signing_key, ~0 );
+      db.clear_pending();
+      pending_txs = 0;
+      return block;
+   }
+
+   /// Build a transaction containing only @p op
+   precomputable_transaction prepare( operation op )
+   {
+      db.current_fee_schedule().set_fee( op );
+      trx.clear();
+      set_expiration( db, trx );
+      trx.operations.push_back( std::move( op ) );
+      return precomputable_transaction( trx );
+   }
+
+   /// Push a transaction, generating a block first if enough transactions are pending
+   processed_transaction push( const precomputable_transaction& ptrx )
+   {
+      if( pending_txs >= txs_per_block )
+         produce_block();
+      ++pending_txs;
+      return db.push_transaction( ptrx, ~0 );
+   }
+
+   processed_transaction push_op( operation op )
+   {
+      return push( prepare( std::move( op ) ) );
+   }
+
+   account_create_operation make_benchmark_account( const string& name )const
+   {
+      account_create_operation op;
+      op.registrar = committee_account;
+      op.referrer = committee_account;
+      op.name = name;
+      op.owner = authority( 1, init_account_pub_key, 1 );
+      op.active = op.owner;
+      op.options.memo_key = init_account_pub_key;
+      op.options.voting_account = GRAPHENE_PROXY_TO_SELF_ACCOUNT;
+      return op;
+   }
+
+   /// Create @p count accounts, each funded with @p balance
+   vector<account_id_type> create_benchmark_accounts( const string& prefix, uint32_t count, const asset& balance )
+   {
+      vector<account_id_type> result;
+      result.reserve( count );
+      for( uint32_t i = 0; i < count; ++i )
+      {
+         const auto ptrx = push_op( make_benchmark_account( prefix + fc::to_string( i ) ) );
+         result.emplace_back( ptrx.operation_results[0].get<object_id_type>() );
+         if( balance.amount > 0 )
+         {
+            transfer_operation top;
+            top.from = committee_account;
+            top.to = result.back();
+            top.amount = balance;
+            push_op( top );
+         }
+      }
+      produce_block();
+      return result;
+   }
+};
+
+} } } // graphene::chain::test
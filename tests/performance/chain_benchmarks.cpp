@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/chain/hardfork.hpp>
+
+#include <graphene/chain/account_object.hpp>
+#include <graphene/chain/asset_object.hpp>
+#include <graphene/chain/market_object.hpp>
+#include <graphene/chain/proposal_object.hpp>
+
+#include "../common/database_fixture.hpp"
+#include "benchmark.hpp"
+#include "chain_benchmark_fixture.hpp"
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+BOOST_FIXTURE_TEST_SUITE( chain_benchmarks, chain_benchmark_fixture )
+
+BOOST_AUTO_TEST_CASE( transfer_benchmark )
+{ try {
+   advance_past_hardforks();
+   const uint32_t num_accounts = std::max<uint32_t>( 2, benchmark_scaled( 1000 ) );
+   const uint32_t num_transfers = benchmark_scaled( 50000 );
+   const auto accounts = create_benchmark_accounts( "xfer", num_accounts, asset( 1000000 * GRAPHENE_BLOCKCHAIN_PRECISION ) );
+
+   benchmark_recorder recorder( "transfer" );
+   recorder.parameter( "accounts", num_accounts ).parameter( "transfers", num_transfers );
+
+   std::uniform_int_distribution<uint32_t> pick( 0, num_accounts - 1 );
+   transfer_operation op;
+   for( uint32_t i = 0; i < num_transfers; ++i )
+   {
+      const uint32_t from = pick( rng );
+      op.from = accounts[from];
+      op.to = accounts[ ( from + 1 + pick( rng ) % ( num_accounts - 1 ) ) % num_accounts ];
+      op.amount = asset( 1 + i ); // make every transaction unique
+      const auto ptrx = prepare( op );
+      recorder.measure( [&]() { push( ptrx ); } );
+   }
+   produce_block();
+
+   recorder.report();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( account_create_benchmark )
+{ try {
+   advance_past_hardforks();
+   const uint32_t num_accounts = benchmark_scaled( 20000 );
+
+   benchmark_recorder recorder( "account_create" );
+   recorder.parameter( "accounts", num_accounts );
+
+   for( uint32_t i = 0; i < num_accounts; ++i )
+   {
+      const auto ptrx = prepare( make_benchmark_account( "acct" + fc::to_string( i ) ) );
+      recorder.measure( [&]() { push( ptrx ); } );
+   }
+   produce_block();
+
+   recorder.report();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( limit_order_benchmark )
+{ try {
+   advance_past_hardforks();
+   const uint32_t book_depth = benchmark_scaled( 20000 );
+   const uint32_t levels_per_taker = 5;
+   const uint32_t num_takers = std::max<uint32_t>( 1, book_depth / ( 2 * levels_per_taker ) );
+   const uint32_t num_makers = std::max<uint32_t>( 1, book_depth / 100 );
+   const int64_t maker_order_size = 100;
+
+   ACTORS( (issuer)(taker) );
+   const asset_id_type usd_id = create_user_issued_asset( "BENCHUSD", issuer, 0 ).get_id();
+   const asset_id_type core_id = asset_id_type();
+   fund( taker, asset( 1000000 * GRAPHENE_BLOCKCHAIN_PRECISION ) );
+   const auto makers = create_benchmark_accounts( "maker", num_makers, asset( 1000 * GRAPHENE_BLOCKCHAIN_PRECISION ) );
+   for( const auto& maker : makers )
+      issue_uia( maker, asset( maker_order_size * book_depth, usd_id ) );
+   produce_block();
+
+   // Build the book, every order at its own price level
+   benchmark_recorder maker_recorder( "limit_order_create_maker" );
+   maker_recorder.parameter( "book_depth", book_depth ).parameter( "makers", num_makers );
+   for( uint32_t i = 0; i < book_depth; ++i )
+   {
+      const auto ptrx = prepare( make_limit_order_create_op( makers[ i % num_makers ],
+                                                             asset( maker_order_size, usd_id ),
+                                                             asset( 1000 + i, core_id ) ) );
+      maker_recorder.measure( [&]() { push( ptrx ); } );
+   }
+   produce_block();
+   maker_recorder.report();
+
+   // Take liquidity, every order filling several price levels
+   const auto& limit_index = db.get_index_type<limit_order_index>().indices();
+   const size_t orders_before = limit_index.size();
+   benchmark_recorder taker_recorder( "limit_order_create_taker" );
+   taker_recorder.parameter( "book_depth", book_depth ).parameter( "takers", num_takers )
+                 .parameter( "levels_per_taker", levels_per_taker );
+   for( uint32_t i = 0; i < num_takers; ++i )
+   {
+      const auto ptrx = prepare( make_limit_order_create_op( taker_id,
+                                                             asset( 1000 * levels_per_taker + i, core_id ),
+                                                             asset( 1, usd_id ) ) );
+      taker_recorder.measure( [&]() { push( ptrx ); } );
+   }
+   produce_block();
+   BOOST_CHECK_LT( limit_index.size(), orders_before );
+   taker_recorder.parameter( "maker_orders_filled", orders_before - limit_index.size() );
+   taker_recorder.report();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( margin_call_benchmark )
+{ try {
+   advance_past_hardforks();
+   const uint32_t num_calls = benchmark_scaled( 5000 );
+   const uint32_t num_feed_steps = 100;
+   const int64_t debt_per_call = 10000;
+   const int64_t total_debt = debt_per_call * num_calls;
+
+   ACTORS( (feeder)(maker) );
+   const asset_id_type usd_id = create_bitasset( "BENCHBIT", feeder_id, 0, 0 ).get_id();
+   const asset_id_type core_id = asset_id_type();
+   update_feed_producers( usd_id, { feeder_id } );
+
+   // 1 USD for 1 CORE, MCR 1.75, MSSR 1.5
+   price_feed feed;
+   feed.settlement_price = asset( 1000, usd_id ) / asset( 1000, core_id );
+   feed.core_exchange_rate = feed.settlement_price;
+   feed.maintenance_collateral_ratio = 1750;
+   feed.maximum_short_squeeze_ratio = 1500;
+   publish_feed( usd_id, feeder_id, feed );
+
+   // The maker is so well collateralized that it is never margin called, and sells enough USD to cover all calls
+   transfer( committee_account, maker_id, asset( total_debt * 10 ) );
+   borrow( maker_id, asset( total_debt, usd_id ), asset( total_debt * 10 ) );
+   create_sell_order( maker_id, asset( total_debt, usd_id ), asset( total_debt, core_id ) );
+
+   // Call orders with collateral ratios spread evenly between 2 and 4
+   const auto borrowers = create_benchmark_accounts( "borrower", num_calls, asset( debt_per_call * 4 ) );
+   for( uint32_t i = 0; i < num_calls; ++i )
+   {
+      call_order_update_operation op;
+      op.funding_account = borrowers[i];
+      op.delta_debt = asset( debt_per_call, usd_id );
+      op.delta_collateral = asset( debt_per_call * 2 + ( debt_per_call * 2 * i ) / num_calls, core_id );
+      push_op( op );
+   }
+   produce_block();
+
+   // Raise the price of USD step by step, so that every feed update margin calls a slice of the call orders
+   const auto& call_index = db.get_index_type<call_order_index>().indices();
+   benchmark_recorder recorder( "margin_call" );
+   recorder.parameter( "call_orders", num_calls ).parameter( "feed_steps", num_feed_steps );
+   asset_publish_feed_operation op;
+   op.publisher = feeder_id;
+   op.asset_id = usd_id;
+   op.feed = feed;
+   for( uint32_t step = 1; step <= num_feed_steps; ++step )
+   {
+      // from 1.1 to 2.3 CORE per USD
+      op.feed.settlement_price = asset( 1000, usd_id ) / asset( 1100 + ( 1200 * step ) / num_feed_steps, core_id );
+      op.feed.core_exchange_rate = op.feed.settlement_price;
+      const auto ptrx = prepare( op );
+      const size_t calls_before = call_index.size();
+      recorder.measure( [&]() { push( ptrx ); }, 0 );
+      recorder.add_operations( calls_before - call_index.size() ); // margin calls are the operations here
+   }
+   produce_block();
+   BOOST_CHECK( !usd_id(db).bitasset_data(db).is_globally_settled() );
+
+   recorder.report();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( proposal_benchmark )
+{ try {
+   advance_past_hardforks();
+   const uint32_t num_proposals = benchmark_scaled( 5000 );
+   const auto accounts = create_benchmark_accounts( "prop", 2, asset( 1000000 * GRAPHENE_BLOCKCHAIN_PRECISION ) );
+
+   benchmark_recorder create_recorder( "proposal_create" );
+   create_recorder.parameter( "proposals", num_proposals );
+   vector<proposal_id_type> proposals;
+   proposals.reserve( num_proposals );
+   transfer_operation top;
+   top.from = accounts[0];
+   top.to = accounts[1];
+   for( uint32_t i = 0; i < num_proposals; ++i )
+   {
+      top.amount = asset( 1 + i );
+      const auto ptrx = prepare( make_proposal_create_op( top, accounts[0], 86400 ) );
+      processed_transaction result;
+      create_recorder.measure( [&]() { result = push( ptrx ); } );
+      proposals.emplace_back( result.operation_results[0].get<object_id_type>() );
+   }
+   produce_block();
+   create_recorder.report();
+
+   // Every approval makes the proposal executable, so it is executed right away
+   benchmark_recorder approve_recorder( "proposal_update_and_execute" );
+   approve_recorder.parameter( "proposals", num_proposals );
+   proposal_update_operation uop;
+   uop.fee_paying_account = accounts[0];
+   uop.active_approvals_to_add.insert( accounts[0] );
+   for( const auto& proposal_id : proposals )
+   {
+      uop.proposal = proposal_id;
+      const auto ptrx = prepare( uop );
+      approve_recorder.measure( [&]() { push( ptrx ); } );
+   }
+   produce_block();
+   BOOST_CHECK( db.get_index_type<proposal_index>().indices().empty() );
+   approve_recorder.report();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( maintenance_benchmark )
+{ try {
+   advance_past_hardforks();
+   const uint32_t num_accounts = benchmark_scaled( 1000000 );
+
+   vector<vote_id_type> witness_votes;
+   for( const auto& witness_id : db.get_global_properties().active_witnesses )
+      witness_votes.push_back( witness_id(db).vote_id );
+   vector<vote_id_type> committee_votes;
+   for( const auto& committee_member_id : db.get_global_properties().active_committee_members )
+      committee_votes.push_back( committee_member_id(db).vote_id );
+   std::uniform_int_distribution<size_t> pick_witness( 0, witness_votes.size() - 1 );
+   std::uniform_int_distribution<size_t> pick_committee_member( 0, committee_votes.size() - 1 );
+
+   // Create voting accounts with balances outside of blocks and without undo history, like during a replay
+   db._undo_db.disable();
+   transfer_operation top;
+   top.from = committee_account;
+   top.amount = asset( 1000 * GRAPHENE_BLOCKCHAIN_PRECISION );
+   for( uint32_t i = 0; i < num_accounts; ++i )
+   {
+      account_create_operation aop = make_benchmark_account( "voter" + fc::to_string( i ) );
+      aop.options.votes.insert( witness_votes[ pick_witness( rng ) ] );
+      aop.options.votes.insert( committee_votes[ pick_committee_member( rng ) ] );
+      aop.options.num_witness = 1;
+      aop.options.num_committee = 1;
+      const auto result = db.apply_transaction( prepare( aop ), ~0 );
+      top.to = account_id_type( result.operation_results[0].get<object_id_type>() );
+      db.apply_transaction( prepare( top ), ~0 );
+   }
+   db._undo_db.enable();
+
+   // Skip to the last slot before the maintenance time
+   const auto next_maintenance_time = db.get_dynamic_global_properties().next_maintenance_time;
+   uint32_t slots = db.get_slot_at_time( next_maintenance_time );
+   if( slots > 0 && db.get_slot_time( slots ) == next_maintenance_time )
+      --slots;
+   if( slots > 0 )
+      produce_block( slots - 1 );
+   BOOST_REQUIRE( db.get_slot_time( 1 ) >= next_maintenance_time );
+
+   benchmark_recorder recorder( "maintenance" );
+   recorder.parameter( "accounts", num_accounts );
+   recorder.measure( [this]() { produce_block(); }, num_accounts );
+   BOOST_CHECK( db.get_dynamic_global_properties().next_maintenance_time > next_maintenance_time );
+   recorder.report();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( pop_block_benchmark )
+{ try {
+   advance_past_hardforks();
+   const uint32_t num_blocks = benchmark_scaled( 200 );
+   const uint32_t num_accounts = 100;
+   const uint32_t transfers_per_block = 200;
+   const auto accounts = create_benchmark_accounts( "undo", num_accounts,
+                                                    asset( 1000000 * GRAPHENE_BLOCKCHAIN_PRECISION ) );
+
+   benchmark_recorder pop_recorder( "pop_block" );
+   pop_recorder.parameter( "blocks", num_blocks ).parameter( "transfers_per_block", transfers_per_block );
+   benchmark_recorder push_recorder( "push_block" );
+   push_recorder.parameter( "blocks", num_blocks ).parameter( "transfers_per_block", transfers_per_block );
+
+   // Undo every block right after it is generated, then apply it again
+   transfer_operation op;
+   uint32_t transfers = 0;
+   for( uint32_t b = 0; b < num_blocks; ++b )
+   {
+      for( uint32_t t = 0; t < transfers_per_block; ++t, ++transfers )
+      {
+         op.from = accounts[ t % num_accounts ];
+         op.to = accounts[ ( t + 1 ) % num_accounts ];
+         op.amount = asset( 1 + transfers );
+         push_op( op );
+      }
+      const signed_block block = produce_block();
+
+      pop_recorder.measure( [this]() { db.pop_block(); }, transfers_per_block );
+      db._popped_tx.clear();
+      db.clear_pending();
+      push_recorder.measure( [&]() { db.push_block( block, ~0 ); }, transfers_per_block );
+      BOOST_REQUIRE( db.head_block_id() == block.id() );
+   }
+
+   pop_recorder.report();
+   push_recorder.report();
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
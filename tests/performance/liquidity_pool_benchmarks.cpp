@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/chain/account_object.hpp>
+#include <graphene/chain/asset_object.hpp>
+#include <graphene/chain/liquidity_pool_object.hpp>
+
+#include "chain_benchmark_fixture.hpp"
+
+#include <fc/crypto/sha256.hpp>
+#include <fc/io/raw.hpp>
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+namespace {
+
+/// Number of swaps which are put into one block
+const uint32_t swaps_per_block = 200;
+
+/// Amount of each asset deposited into every pool
+const int64_t pool_depth = 1000000000;
+
+/// Amount of each pool asset held by every trader
+const int64_t trader_asset_balance = 10000000;
+
+struct liquidity_pool_benchmark_fixture : chain_benchmark_fixture
+{
+   struct benchmark_pool
+   {
+      liquidity_pool_id_type  id;
+      asset_id_type           asset_a;
+      asset_id_type           asset_b;
+   };
+
+   vector<benchmark_pool>   pools;
+   vector<account_id_type>  traders;
+
+   /// Create @p num_pools pools of distinct asset pairs without market fees and traders holding both assets of each
+   void setup_pools( uint32_t num_pools, uint32_t num_traders, uint16_t taker_fee_percent )
+   {
+      const account_id_type issuer = create_account( "lpissuer" ).get_id();
+      fund( issuer(db), asset( 1000000 * GRAPHENE_BLOCKCHAIN_PRECISION ) );
+      traders = create_benchmark_accounts( "swapper", num_traders, asset( 1000 * GRAPHENE_BLOCKCHAIN_PRECISION ) );
+
+      for( uint32_t i = 0; i < num_pools; ++i )
+      {
+         const string suffix = fc::to_string( i );
+         const asset_id_type asset_a = create_user_issued_asset( "POOLA" + suffix, issuer(db), 0 ).get_id();
+         const asset_id_type asset_b = create_user_issued_asset( "POOLB" + suffix, issuer(db), 0 ).get_id();
+         const asset_id_type share_asset = create_user_issued_asset( "POOLS" + suffix, issuer(db), 0 ).get_id();
+         const liquidity_pool_id_type pool = create_liquidity_pool( issuer, asset_a, asset_b, share_asset,
+                                                                    taker_fee_percent, 0 ).get_id();
+
+         push_op( make_issue_op( issuer, asset( pool_depth, asset_a ) ) );
+         push_op( make_issue_op( issuer, asset( pool_depth, asset_b ) ) );
+         push_op( make_liquidity_pool_deposit_op( issuer, pool, asset( pool_depth, asset_a ),
+                                                  asset( pool_depth, asset_b ) ) );
+         for( const auto& trader : traders )
+         {
+            push_op( make_issue_op( trader, asset( trader_asset_balance, asset_a ) ) );
+            push_op( make_issue_op( trader, asset( trader_asset_balance, asset_b ) ) );
+         }
+         pools.push_back( { pool, asset_a, asset_b } );
+      }
+      produce_block();
+   }
+
+   asset_issue_operation make_issue_op( account_id_type to, const asset& amount )const
+   {
+      asset_issue_operation op;
+      op.issuer = amount.asset_id(db).issuer;
+      op.asset_to_issue = amount;
+      op.issue_to_account = to;
+      return op;
+   }
+
+   /// @return a swap of a random amount of either asset of a random pool by a random trader at any price
+   liquidity_pool_exchange_operation make_swap()
+   {
+      const benchmark_pool& pool = pools[ rng() % pools.size() ];
+      const account_id_type trader = traders[ rng() % traders.size() ];
+      const bool sell_a = ( rng() % 2 == 0 );
+      const int64_t amount = 100 + rng() % 10000;
+      return make_liquidity_pool_exchange_op( trader, pool.id, asset( amount, sell_a ? pool.asset_a : pool.asset_b ),
+                                              asset( 1, sell_a ? pool.asset_b : pool.asset_a ) );
+   }
+
+   /// @return a hash of all pools and balances
+   fc::sha256 pool_state_hash()const
+   {
+      fc::sha256::encoder enc;
+      for( const auto& pool : db.get_index_type<liquidity_pool_index>().indices() )
+         fc::raw::pack( enc, pool );
+      for( const auto& balance : db.get_index_type<account_balance_index>().indices() )
+         fc::raw::pack( enc, balance );
+      return enc.result();
+   }
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE( liquidity_pool_benchmarks, liquidity_pool_benchmark_fixture )
+
+/**
+ * Let many traders swap against a few liquidity pools and report the swaps per second and the heap allocations per
+ * swap. Runs with the same seed must report the same hash of the resulting pool state.
+ */
+BOOST_AUTO_TEST_CASE( liquidity_pool_swap_benchmark )
+{ try {
+   advance_past_hardforks();
+   setup_pools( std::max<uint32_t>( 1, benchmark_scaled( 4 ) ), std::max<uint32_t>( 1, benchmark_scaled( 100 ) ), 30 );
+
+   const uint32_t num_swaps = benchmark_scaled( 20000 );
+   benchmark_recorder recorder( "liquidity_pool_swaps" );
+   recorder.parameter( "pools", pools.size() ).parameter( "traders", traders.size() );
+
+   uint32_t rejected = 0;
+   vector<precomputable_transaction> block_txs;
+   block_txs.reserve( swaps_per_block );
+   for( uint32_t first = 0; first < num_swaps; first += swaps_per_block )
+   {
+      block_txs.clear();
+      for( uint32_t i = first; i < num_swaps && i < first + swaps_per_block; ++i )
+         block_txs.push_back( prepare( make_swap() ) );
+      const uint32_t rejected_before = rejected;
+      recorder.measure( [&]() {
+         for( const auto& ptrx : block_txs )
+         {
+            try {
+               push( ptrx );
+            } catch( const fc::exception& ) {
+               ++rejected;
+            }
+         }
+         produce_block();
+      }, 0 );
+      recorder.add_operations( block_txs.size() - ( rejected - rejected_before ) );
+   }
+
+   recorder.parameter( "swaps", num_swaps ).parameter( "rejected", rejected )
+           .parameter( "blocks", recorder.sample_count() ).parameter( "state_hash", pool_state_hash().str() );
+   recorder.report();
+
+   for( const auto& pool : pools )
+   {
+      BOOST_CHECK( pool.id(db).balance_a > 0 );
+      BOOST_CHECK( pool.id(db).balance_b > 0 );
+   }
+   BOOST_CHECK_LT( rejected, num_swaps );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
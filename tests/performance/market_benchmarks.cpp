@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/chain/account_object.hpp>
+#include <graphene/chain/asset_object.hpp>
+#include <graphene/chain/market_object.hpp>
+
+#include "chain_benchmark_fixture.hpp"
+
+#include <fc/crypto/sha256.hpp>
+#include <fc/filesystem.hpp>
+#include <fc/io/json.hpp>
+#include <fc/io/raw.hpp>
+
+#include <boost/signals2/connection.hpp>
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+
+namespace {
+
+/// Number of transactions of the order stream which are put into one block
+const uint32_t market_txs_per_block = 100;
+
+/// Core balance of every trader, enough to collateralize all call orders of the workload
+const int64_t trader_balance = 100000 * GRAPHENE_BLOCKCHAIN_PRECISION;
+
+/**
+ * The operations of a market benchmark. The setup operations build the order book, the stream is replayed on it.
+ * Both refer to the traders and the asset created by @ref market_benchmark_fixture::setup_market, so a workload can
+ * only be replayed with the number of traders it was generated for.
+ */
+struct market_workload
+{
+   uint32_t           traders = 0;
+   vector<operation>  setup;
+   vector<operation>  stream;
+   string             state_hash; ///< of the market state after the replay, empty if not known yet
+
+   fc::variant to_variant()const
+   {
+      fc::mutable_variant_object result;
+      result( "traders", traders )
+            ( "setup", fc::variant( setup, GRAPHENE_MAX_NESTED_OBJECTS ) )
+            ( "stream", fc::variant( stream, GRAPHENE_MAX_NESTED_OBJECTS ) )
+            ( "state_hash", state_hash );
+      return result;
+   }
+
+   static market_workload from_variant( const fc::variant& v )
+   {
+      const fc::variant_object& obj = v.get_object();
+      market_workload result;
+      result.traders = obj["traders"].as_uint64();
+      result.setup = obj["setup"].as<vector<operation>>( GRAPHENE_MAX_NESTED_OBJECTS );
+      result.stream = obj["stream"].as<vector<operation>>( GRAPHENE_MAX_NESTED_OBJECTS );
+      result.state_hash = obj["state_hash"].as_string();
+      return result;
+   }
+};
+
+struct market_benchmark_fixture : chain_benchmark_fixture
+{
+   account_id_type          feeder;
+   asset_id_type            mpa_id;
+   vector<account_id_type>  traders;
+
+   /// Create a market issued asset which settles individually to an order, its feed producer and the traders
+   void setup_market( uint32_t num_traders )
+   {
+      feeder = create_account( "feeder" ).get_id();
+      fund( feeder(db), asset( 1000000 * GRAPHENE_BLOCKCHAIN_PRECISION ) );
+
+      asset_create_operation acop;
+      acop.issuer = feeder;
+      acop.symbol = "BENCHMPA";
+      acop.precision = 4;
+      acop.common_options.core_exchange_rate = price( asset( 1, asset_id_type(1) ), asset( 1 ) );
+      acop.common_options.max_supply = GRAPHENE_MAX_SHARE_SUPPLY;
+      acop.common_options.market_fee_percent = 0;
+      acop.common_options.flags = 0;
+      acop.common_options.issuer_permissions = ASSET_ISSUER_PERMISSION_ENABLE_BITS_MASK;
+      acop.bitasset_opts = bitasset_options();
+      acop.bitasset_opts->minimum_feeds = 1;
+      // Let force settlements come due during the replay, without a volume limit
+      acop.bitasset_opts->force_settlement_delay_sec = 300;
+      acop.bitasset_opts->maximum_force_settlement_volume = GRAPHENE_100_PERCENT;
+      acop.bitasset_opts->extensions.value.black_swan_response_method
+            = static_cast<uint8_t>( bitasset_options::black_swan_response_type::individual_settlement_to_order );
+      const auto ptrx = push_op( acop );
+      mpa_id = asset_id_type( ptrx.operation_results[0].get<object_id_type>() );
+
+      produce_block();
+      update_feed_producers( mpa_id, { feeder } );
+      push_op( make_feed_op( 1000 ) );
+
+      traders = create_benchmark_accounts( "trader", num_traders, asset( trader_balance ) );
+   }
+
+   /// @return a feed op with a settlement price of @p core_per_mpa_milli / 1000 CORE per MPA
+   asset_publish_feed_operation make_feed_op( int64_t core_per_mpa_milli )const
+   {
+      asset_publish_feed_operation op;
+      op.publisher = feeder;
+      op.asset_id = mpa_id;
+      op.feed.settlement_price = asset( 1000, mpa_id ) / asset( core_per_mpa_milli, asset_id_type() );
+      op.feed.core_exchange_rate = op.feed.settlement_price;
+      op.feed.maintenance_collateral_ratio = 1750;
+      op.feed.maximum_short_squeeze_ratio = 1500;
+      return op;
+   }
+
+   /// @return an order which sells or buys @p mpa_amount MPA at @p core_per_mpa_milli / 1000 CORE per MPA
+   limit_order_create_operation make_order( account_id_type seller, bool sell_mpa, int64_t mpa_amount,
+                                            int64_t core_per_mpa_milli )const
+   {
+      const asset mpa( mpa_amount, mpa_id );
+      const asset core( std::max<int64_t>( 1, mpa_amount * core_per_mpa_milli / 1000 ) );
+      return sell_mpa ? make_limit_order_create_op( seller, mpa, core )
+                      : make_limit_order_create_op( seller, core, mpa );
+   }
+
+   /// @return an update which borrows @p debt MPA at a collateral ratio of @p cr_milli / 1000
+   call_order_update_operation make_borrow_op( account_id_type borrower, int64_t debt, int64_t core_per_mpa_milli,
+                                               int64_t cr_milli )const
+   {
+      call_order_update_operation op;
+      op.funding_account = borrower;
+      op.delta_debt = asset( debt, mpa_id );
+      op.delta_collateral = asset( debt * core_per_mpa_milli / 1000 * cr_milli / 1000 );
+      return op;
+   }
+
+   /**
+    * Generate a workload from the random number generator of the fixture.
+    *
+    * The setup opens one call order per trader with a collateral ratio between 2 and 4, places @p book_orders
+    * limit orders which do not cross, and requests @p settle_orders force settlements. The stream consists of
+    * limit orders around the feed price of which about a third cross the book, feed updates which move the price
+    * by up to 70% so that call orders are margin called and individually settled, new debt and force settlements.
+    */
+   market_workload generate_workload( uint32_t book_orders, uint32_t settle_orders, uint32_t stream_ops )
+   {
+      market_workload workload;
+      workload.traders = static_cast<uint32_t>( traders.size() );
+      std::uniform_int_distribution<size_t> pick_trader( 0, traders.size() - 1 );
+      std::uniform_int_distribution<int64_t> pick_debt( 1000000, 100000000 );
+      std::uniform_int_distribution<int64_t> pick_cr( 2000, 4000 );
+      std::uniform_int_distribution<int64_t> pick_order_size( 10000, 1000000 );
+      std::uniform_int_distribution<int64_t> pick_spread( 5, 50 );
+      std::uniform_int_distribution<int64_t> pick_stream_spread( -20, 50 );
+      std::uniform_int_distribution<int64_t> pick_feed_step( -40, 40 );
+      std::uniform_int_distribution<uint32_t> pick_percent( 0, 99 );
+      std::bernoulli_distribution pick_side;
+      int64_t feed_milli = 1000;
+
+      workload.setup.reserve( traders.size() + book_orders + settle_orders );
+      for( const auto& trader : traders )
+         workload.setup.push_back( make_borrow_op( trader, pick_debt( rng ), feed_milli, pick_cr( rng ) ) );
+      for( uint32_t i = 0; i < book_orders; ++i )
+      {
+         const bool sell_mpa = pick_side( rng );
+         const int64_t spread = pick_spread( rng );
+         workload.setup.push_back( make_order( traders[ pick_trader( rng ) ], sell_mpa, pick_order_size( rng ),
+                                               sell_mpa ? feed_milli + spread : feed_milli - spread ) );
+      }
+      asset_settle_operation settle_op;
+      for( uint32_t i = 0; i < settle_orders; ++i )
+      {
+         settle_op.account = traders[ pick_trader( rng ) ];
+         settle_op.amount = asset( pick_order_size( rng ), mpa_id );
+         workload.setup.push_back( settle_op );
+      }
+
+      workload.stream.reserve( stream_ops );
+      for( uint32_t i = 0; i < stream_ops; ++i )
+      {
+         const uint32_t kind = pick_percent( rng );
+         if( kind < 60 )
+         {
+            const bool sell_mpa = pick_side( rng );
+            const int64_t spread = pick_stream_spread( rng );
+            workload.stream.push_back( make_order( traders[ pick_trader( rng ) ], sell_mpa, pick_order_size( rng ),
+                                                   sell_mpa ? feed_milli + spread : feed_milli - spread ) );
+         }
+         else if( kind < 75 )
+         {
+            feed_milli = std::min<int64_t>( 1700, std::max<int64_t>( 700, feed_milli + pick_feed_step( rng ) ) );
+            workload.stream.push_back( make_feed_op( feed_milli ) );
+         }
+         else if( kind < 90 )
+            workload.stream.push_back( make_borrow_op( traders[ pick_trader( rng ) ], pick_debt( rng ) / 10,
+                                                       feed_milli, pick_cr( rng ) ) );
+         else
+         {
+            settle_op.account = traders[ pick_trader( rng ) ];
+            settle_op.amount = asset( pick_order_size( rng ), mpa_id );
+            workload.stream.push_back( settle_op );
+         }
+      }
+      return workload;
+   }
+
+   /**
+    * Push @p ops in blocks of @ref market_txs_per_block transactions, one sample per block.
+    * Operations which fail, e.g. force settlements without enough balance, are counted but not retried.
+    * The operations of the recorder are the matches, i.e. the fills of maker orders, including those of
+    * force settlements which come due while blocks are applied.
+    */
+   void replay( benchmark_recorder& recorder, const vector<operation>& ops )
+   {
+      uint64_t matches = 0;
+      boost::signals2::scoped_connection connection = db.applied_block.connect( [this,&matches]( const signed_block& )
+      {
+         for( const auto& applied_op : db.get_applied_operations() )
+         {
+            if( applied_op.valid() && applied_op->op.is_type<fill_order_operation>()
+                  && applied_op->op.get<fill_order_operation>().is_maker )
+               ++matches;
+         }
+      });
+
+      uint32_t rejected = 0;
+      vector<precomputable_transaction> block_txs;
+      block_txs.reserve( market_txs_per_block );
+      for( size_t first = 0; first < ops.size(); first += market_txs_per_block )
+      {
+         block_txs.clear();
+         for( size_t i = first; i < ops.size() && i < first + market_txs_per_block; ++i )
+            block_txs.push_back( prepare( ops[i] ) );
+         const uint64_t matches_before = matches;
+         recorder.measure( [&]() {
+            for( const auto& ptrx : block_txs )
+            {
+               try {
+                  push( ptrx );
+               } catch( const fc::exception& ) {
+                  ++rejected;
+               }
+            }
+            produce_block();
+         }, 0 );
+         recorder.add_operations( matches - matches_before );
+      }
+      recorder.parameter( "transactions", ops.size() ).parameter( "rejected", rejected )
+              .parameter( "blocks", recorder.sample_count() );
+   }
+
+   /// @return a hash of all orders, balances and the data of the market issued asset
+   fc::sha256 market_state_hash()const
+   {
+      fc::sha256::encoder enc;
+      for( const auto& order : db.get_index_type<limit_order_index>().indices() )
+         fc::raw::pack( enc, order );
+      for( const auto& order : db.get_index_type<call_order_index>().indices() )
+         fc::raw::pack( enc, order );
+      for( const auto& order : db.get_index_type<force_settlement_index>().indices() )
+         fc::raw::pack( enc, order );
+      for( const auto& balance : db.get_index_type<account_balance_index>().indices() )
+         fc::raw::pack( enc, balance );
+      const asset_object& mpa = mpa_id(db);
+      fc::raw::pack( enc, mpa.bitasset_data(db) );
+      fc::raw::pack( enc, mpa.dynamic_data(db) );
+      return enc.result();
+   }
+};
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE( market_benchmarks, market_benchmark_fixture )
+
+/**
+ * Build an order book with limit orders, call orders and queued force settlements, then replay an order stream on
+ * it and report the matches per second and the heap allocations per match.
+ *
+ * If the @c GRAPHENE_BENCHMARK_MARKET_STREAM environment variable names an existing file, the workload is read from
+ * it and the market state after the replay must have the hash recorded in it. Otherwise a workload is generated, and
+ * saved to the file with the resulting hash if the variable is set. Recording a workload with one build and replaying
+ * it with another verifies that both match orders identically.
+ */
+BOOST_AUTO_TEST_CASE( market_replay_benchmark )
+{ try {
+   advance_past_hardforks();
+
+   const char* stream_file_str = getenv( "GRAPHENE_BENCHMARK_MARKET_STREAM" );
+   const fc::path stream_file( stream_file_str != nullptr ? stream_file_str : "" );
+   const bool recorded = ( stream_file_str != nullptr && fc::exists( stream_file ) );
+   market_workload workload;
+   if( recorded )
+   {
+      workload = market_workload::from_variant( fc::json::from_file( stream_file ) );
+      setup_market( workload.traders );
+   }
+   else
+   {
+      setup_market( std::max<uint32_t>( 2, benchmark_scaled( 200 ) ) );
+      workload = generate_workload( benchmark_scaled( 10000 ), benchmark_scaled( 500 ), benchmark_scaled( 20000 ) );
+   }
+
+   benchmark_recorder setup_recorder( "market_book_setup" );
+   setup_recorder.parameter( "traders", workload.traders ).parameter( "recorded", recorded );
+   replay( setup_recorder, workload.setup );
+   setup_recorder.report();
+   BOOST_CHECK( !db.get_index_type<limit_order_index>().indices().empty() );
+   BOOST_CHECK( !db.get_index_type<call_order_index>().indices().empty() );
+
+   benchmark_recorder stream_recorder( "market_replay" );
+   stream_recorder.parameter( "traders", workload.traders ).parameter( "recorded", recorded );
+   replay( stream_recorder, workload.stream );
+
+   const string state_hash = market_state_hash().str();
+   stream_recorder.parameter( "state_hash", state_hash );
+   stream_recorder.report();
+
+   if( recorded )
+      BOOST_CHECK_EQUAL( state_hash, workload.state_hash );
+   else if( stream_file_str != nullptr )
+   {
+      workload.state_hash = state_hash;
+      fc::json::save_to_file( workload.to_variant(), stream_file );
+   }
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
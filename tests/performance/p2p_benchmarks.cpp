@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/net/node.hpp>
+
+#include <fc/thread/thread.hpp>
+
+#include "../../libraries/net/node_impl.hxx"
+
+#include "benchmark.hpp"
+
+#include <atomic>
+
+using namespace graphene::chain::test;
+using graphene::net::item_hash_t;
+using graphene::net::item_id;
+
+namespace {
+
+/// A node delegate which only counts the transactions it is asked to handle
+class counting_delegate : public graphene::net::node_delegate
+{
+public:
+   std::atomic<uint64_t> transactions { 0 };
+
+   bool has_item( const item_id& ) override { return false; }
+   bool handle_block( const graphene::net::block_message&, bool, std::vector<fc::uint160_t>& ) override
+   { return false; }
+   void handle_transaction( const graphene::net::trx_message& ) override { ++transactions; }
+   void handle_message( const graphene::net::message& ) override {}
+   std::vector<item_hash_t> get_block_ids( const std::vector<item_hash_t>&, uint32_t&, uint32_t ) override
+   { return {}; }
+   graphene::net::message get_item( const item_id& ) override { return graphene::net::message(); }
+   graphene::net::chain_id_type get_chain_id()const override { return graphene::net::chain_id_type(); }
+   std::vector<item_hash_t> get_blockchain_synopsis( const item_hash_t&, uint32_t ) override { return {}; }
+   void sync_status( uint32_t, uint32_t ) override {}
+   void connection_count_changed( uint32_t ) override {}
+   uint32_t get_block_number( const item_hash_t& ) override { return 0; }
+   fc::time_point_sec get_block_time( const item_hash_t& ) override { return fc::time_point_sec(); }
+   item_hash_t get_head_block_id()const override { return item_hash_t(); }
+   uint32_t estimate_last_known_fork_from_git_revision_timestamp( uint32_t )const override { return 0; }
+   void error_encountered( const std::string&, const fc::oexception& ) override {}
+   uint8_t get_current_block_interval_in_seconds()const override { return 3; }
+};
+
+/**
+ * Hand transactions over from a p2p thread to a delegate thread with @p handoff, in rounds of @p concurrency
+ * simultaneous calls as if they came from that many peers, and record each round as a sample
+ */
+template<typename Handoff>
+void run_handoff_benchmark( const std::string& workload, Handoff&& handoff )
+{
+   const uint32_t num_transactions = benchmark_scaled( 200000 );
+   const uint32_t concurrency = 50;
+   const uint32_t rounds = std::max<uint32_t>( 1, num_transactions / concurrency );
+
+   benchmark_recorder recorder( workload );
+   recorder.parameter( "transactions", rounds * concurrency ).parameter( "concurrency", concurrency );
+
+   fc::thread p2p_thread( "p2p" );
+   p2p_thread.async( [&]() {
+      graphene::net::trx_message msg;
+      std::vector<fc::future<void>> callers( concurrency );
+      for( uint32_t round = 0; round < rounds; ++round )
+      {
+         recorder.measure( [&]() {
+            for( auto& caller : callers )
+               caller = fc::async( [&handoff,&msg]() { handoff( msg ); } );
+            for( auto& caller : callers )
+               caller.wait();
+         }, concurrency );
+      }
+   }).wait();
+
+   recorder.report();
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE( p2p_benchmarks )
+
+BOOST_AUTO_TEST_CASE( delegate_handoff_benchmark )
+{ try {
+   auto delegate = std::make_shared<counting_delegate>();
+   fc::thread delegate_thread( "delegate" );
+
+   // One task per transaction on the delegate thread, as all delegate calls were made before
+   run_handoff_benchmark( "p2p_handoff_task_per_call", [&]( const graphene::net::trx_message& msg ) {
+      delegate_thread.async( [&]() { delegate->handle_transaction( msg ); } ).wait();
+   });
+   const uint64_t direct_count = delegate->transactions.load();
+
+   // Transactions queued and handled in batches
+   graphene::net::detail::statistics_gathering_node_delegate_wrapper wrapper( delegate, &delegate_thread );
+   run_handoff_benchmark( "p2p_handoff_batched", [&]( const graphene::net::trx_message& msg ) {
+      wrapper.handle_transaction( msg );
+   });
+   BOOST_CHECK_EQUAL( delegate->transactions.load(), 2 * direct_count );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
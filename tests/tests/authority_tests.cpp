@@ -33,6 +33,9 @@
 #include <graphene/chain/proposal_object.hpp>
 #include <graphene/chain/hardfork.hpp>
 
+#include <graphene/protocol/authority_check_cache.hpp>
+#include <graphene/protocol/key_addresses.hpp>
+#include <graphene/protocol/pts_address.hpp>
 #include <graphene/protocol/restriction_predicate.hpp>
 
 #include <graphene/db/simple_index.hpp>
@@ -2400,4 +2403,320 @@ BOOST_AUTO_TEST_CASE( self_deleting_proposal )
    db.get(pid1);
 } FC_LOG_AND_RETHROW() }
 
+
+BOOST_AUTO_TEST_CASE( address_authorities )
+{ try {
+   ACTORS( (alice)(bob) );
+
+   const fc::ecc::private_key test2 = fc::ecc::private_key::regenerate( fc::sha256::hash( std::string( "test-2" ) ) );
+   const public_key_type test2_pub( test2.get_public_key() );
+   const fc::ecc::private_key test3 = fc::ecc::private_key::regenerate( fc::sha256::hash( std::string( "test-3" ) ) );
+   const public_key_type test3_pub( test3.get_public_key() );
+
+   // The cached addresses equal the derived ones, also when served from the cache
+   const key_addresses test2_addrs = derive_key_addresses( test2_pub );
+   BOOST_CHECK( get_key_addresses( test2_pub ) == test2_addrs );
+   BOOST_CHECK( get_key_addresses( test2_pub ) == test2_addrs );
+   BOOST_CHECK( test2_addrs[0] == address( pts_address( test2_pub, false ) ) );
+   BOOST_CHECK( test2_addrs[3] == address( pts_address( test2_pub, true, 0 ) ) );
+   BOOST_CHECK( test2_addrs[4] == address( test2_pub ) );
+
+   transfer_operation to;
+   to.amount = asset( 1 );
+   to.from = alice_id;
+   to.to = bob_id;
+   const vector<operation> ops { to };
+
+   authority alice_auth;
+   alice_auth.weight_threshold = 1;
+   auto get_active = [&alice_auth,alice_id]( account_id_type id ) -> const authority* {
+      return id == alice_id ? &alice_auth : nullptr;
+   };
+   auto get_owner = get_active;
+
+   // Every address of the key is accepted, other keys are not
+   for( const address& addr : test2_addrs )
+   {
+      alice_auth.address_auths.clear();
+      alice_auth.address_auths[ addr ] = 1;
+      verify_authority( ops, { test2_pub }, get_active, get_owner, make_get_custom(db), true, false );
+      GRAPHENE_REQUIRE_THROW( verify_authority( ops, { test3_pub }, get_active, get_owner, make_get_custom(db),
+                                                true, false ), fc::exception );
+   }
+
+   // The cache can be disabled and enabled again
+   set_key_address_cache_capacity( 0 );
+   BOOST_CHECK( get_key_addresses( test2_pub ) == test2_addrs );
+   set_key_address_cache_capacity( 10000 );
+   BOOST_CHECK( get_key_addresses( test3_pub ) == derive_key_addresses( test3_pub ) );
+} FC_LOG_AND_RETHROW() }
+
+
+BOOST_AUTO_TEST_CASE( authority_check_cache_test )
+{ try {
+   ACTORS( (alice)(bob)(carol) );
+   fund( alice );
+   fund( carol );
+
+   const fc::ecc::private_key test2 = fc::ecc::private_key::regenerate( fc::sha256::hash( std::string( "test-2" ) ) );
+   const public_key_type test2_pub( test2.get_public_key() );
+   const fc::ecc::private_key test3 = fc::ecc::private_key::regenerate( fc::sha256::hash( std::string( "test-3" ) ) );
+   const public_key_type test3_pub( test3.get_public_key() );
+
+   // alice needs test2 and test3 or carol
+   account_update_operation auo;
+   auo.account = alice_id;
+   auo.active = authority( 2, test2_pub, 1, test3_pub, 1, carol_id, 2 );
+   trx.clear();
+   set_expiration( db, trx );
+   trx.operations.push_back( auo );
+   sign( trx, alice_private_key );
+   PUSH_TX( db, trx );
+   trx.clear();
+   generate_block();
+
+   auto get_active = [this]( account_id_type id ) { return &id(db).active; };
+   auto get_owner  = [this]( account_id_type id ) { return &id(db).owner;  };
+
+   auto make_transfer = [&]( int64_t amount, const vector<fc::ecc::private_key>& keys ) {
+      signed_transaction tx;
+      transfer_operation to;
+      to.amount = asset( amount );
+      to.from = alice_id;
+      to.to = bob_id;
+      tx.operations.push_back( to );
+      set_expiration( db, tx );
+      for( const auto& key : keys )
+         sign( tx, key );
+      return tx;
+   };
+   auto verify = [&]( const signed_transaction& tx, authority_check_cache* cache ) {
+      tx.verify_authority( db.get_chain_id(), get_active, get_owner, make_get_custom(db), true, false,
+                           GRAPHENE_MAX_SIG_CHECK_DEPTH, cache );
+   };
+
+   authority_check_cache cache;
+   const signed_transaction by_keys = make_transfer( 1, { test2, test3 } );
+   const signed_transaction by_keys2 = make_transfer( 2, { test2, test3 } );
+   const signed_transaction by_carol = make_transfer( 3, { carol_private_key } );
+   const signed_transaction by_test2 = make_transfer( 4, { test2 } );
+   const signed_transaction with_extra_key = make_transfer( 5, { test2, test3, carol_private_key } );
+
+   verify( by_keys, &cache );
+   BOOST_CHECK_EQUAL( cache.size(), 1u );
+   // Same signers, served from the cache
+   verify( by_keys2, &cache );
+   BOOST_CHECK_EQUAL( cache.size(), 1u );
+   verify( by_carol, &cache );
+   verify( by_carol, &cache );
+   BOOST_CHECK_EQUAL( cache.size(), 2u );
+
+   // Failures and unused signatures are detected the same way with and without the cache
+   for( int i = 0; i < 2; ++i )
+   {
+      GRAPHENE_REQUIRE_THROW( verify( by_test2, nullptr ), tx_missing_active_auth );
+      GRAPHENE_REQUIRE_THROW( verify( by_test2, &cache ), tx_missing_active_auth );
+      GRAPHENE_REQUIRE_THROW( verify( with_extra_key, nullptr ), tx_irrelevant_sig );
+      GRAPHENE_REQUIRE_THROW( verify( with_extra_key, &cache ), tx_irrelevant_sig );
+   }
+   BOOST_CHECK_EQUAL( cache.size(), 4u );
+
+   // The database cache is invalidated when an authority changes
+   PUSH_TX( db, by_keys, database::skip_nothing );
+   auo.active = authority( 1, test2_pub, 1 );
+   trx.clear();
+   set_expiration( db, trx );
+   trx.operations.push_back( auo );
+   sign( trx, test2 );
+   sign( trx, test3 );
+   PUSH_TX( db, trx, database::skip_nothing );
+   trx.clear();
+   GRAPHENE_REQUIRE_THROW( PUSH_TX( db, by_keys2, database::skip_nothing ), tx_irrelevant_sig );
+   PUSH_TX( db, make_transfer( 6, { test2 } ), database::skip_nothing );
+   generate_block( database::skip_nothing );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( proposal_authorization_index_test )
+{ try {
+   ACTORS( (alice)(bob)(carol)(dave)(multi) );
+   fund( alice );
+
+   db.modify( multi, [&]( account_object& a ) {
+      a.active = authority( 2, alice_id, 1, bob_id, 1, carol_id, 1 );
+      a.owner = a.active;
+   });
+   // dave can act for carol
+   db.modify( carol, [&]( account_object& a ) {
+      a.active = authority( 1, dave_id, 1 );
+   });
+
+   transfer_operation top;
+   top.from = multi_id;
+   top.to = alice_id;
+   top.amount = asset( 1 );
+   proposal_create_operation pop;
+   pop.fee_paying_account = alice_id;
+   pop.expiration_time = db.head_block_time() + fc::days(1);
+   pop.proposed_ops.emplace_back( top );
+   trx.operations.push_back( pop );
+   const proposal_object& prop = db.get<proposal_object>(
+         PUSH_TX( db, trx, ~0 ).operation_results.front().get<object_id_type>() );
+   trx.clear();
+
+   const auto& tracker = db.get_proposal_authorization_index();
+   auto approve = [&]( account_id_type id, bool add ) {
+      db.modify( prop, [id,add]( proposal_object& p ) {
+         if( add )
+            p.available_active_approvals.insert( id );
+         else
+            p.available_active_approvals.erase( id );
+      });
+   };
+
+   BOOST_CHECK( !tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+
+   approve( alice_id, true );
+   BOOST_CHECK( !tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+
+   // an approval of a nested account counts for the top level entry it belongs to
+   approve( dave_id, true );
+   BOOST_CHECK( tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+   approve( dave_id, false );
+   BOOST_CHECK( !tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+
+   // an approval of the required account itself is enough
+   approve( multi_id, true );
+   BOOST_CHECK( tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+   approve( multi_id, false );
+   BOOST_CHECK( !tracker.may_be_authorized( prop ) );
+
+   // changed authorities are picked up
+   db.modify( multi, [&]( account_object& a ) {
+      a.active = authority( 1, alice_id, 1 );
+   });
+   BOOST_CHECK( tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+   // undone approvals are picked up
+   {
+      auto session = db._undo_db.start_undo_session();
+      approve( alice_id, false );
+      BOOST_CHECK( !tracker.may_be_authorized( prop ) );
+      BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+   }
+   BOOST_CHECK( tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+   db.modify( multi, [&]( account_object& a ) {
+      a.active = authority( 2, alice_id, 1, bob_id, 1, carol_id, 1 );
+   });
+   BOOST_CHECK( !tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+
+   // changed authorities of nested accounts are picked up
+   db.modify( carol, [&]( account_object& a ) {
+      a.active = authority( 1, alice_id, 1 );
+   });
+   BOOST_CHECK( tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+} FC_LOG_AND_RETHROW() }
+
+/// An account approved while checking one authority counts for the others, even beyond the maximum depth
+BOOST_AUTO_TEST_CASE( proposal_authorization_index_depth_test )
+{ try {
+   // xray is created before alpha, so verify_authority checks it first
+   ACTORS( (xray)(yankee)(alpha)(bravo)(romeo) );
+   fund( alpha );
+
+   db.modify( db.get_global_properties(), []( global_property_object& gpo ) {
+      gpo.parameters.max_authority_depth = 2;
+   });
+   const public_key_type key = yankee_private_key.get_public_key();
+   db.modify( romeo, [&]( account_object& a ) {
+      a.active = authority( 2, xray_id, 1, alpha_id, 1 );
+   });
+   db.modify( xray, [&]( account_object& a ) {
+      a.active = authority( 1, yankee_id, 1 );
+   });
+   db.modify( yankee, [&]( account_object& a ) {
+      a.active = authority( 1, key, 1 );
+   });
+   db.modify( alpha, [&]( account_object& a ) {
+      a.active = authority( 1, bravo_id, 1 );
+   });
+   // xray is three levels below romeo along this path, but it is already approved when alpha is checked
+   db.modify( bravo, [&]( account_object& a ) {
+      a.active = authority( 1, xray_id, 1 );
+   });
+
+   transfer_operation top;
+   top.from = romeo_id;
+   top.to = alpha_id;
+   top.amount = asset( 1 );
+   proposal_create_operation pop;
+   pop.fee_paying_account = alpha_id;
+   pop.expiration_time = db.head_block_time() + fc::days(1);
+   pop.proposed_ops.emplace_back( top );
+   trx.operations.push_back( pop );
+   const proposal_object& prop = db.get<proposal_object>(
+         PUSH_TX( db, trx, ~0 ).operation_results.front().get<object_id_type>() );
+   trx.clear();
+
+   const auto& tracker = db.get_proposal_authorization_index();
+   BOOST_CHECK( !tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( !prop.is_authorized_to_execute( db ) );
+
+   db.modify( prop, [&key]( proposal_object& p ) {
+      p.available_key_approvals.insert( key );
+   });
+   BOOST_CHECK( tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+} FC_LOG_AND_RETHROW() }
+
+/// The temporary account is always approved, so an authority which nests it needs no approvals
+BOOST_AUTO_TEST_CASE( proposal_authorization_index_temp_account_test )
+{ try {
+   ACTORS( (alpha)(bravo)(romeo) );
+   fund( alpha );
+
+   db.modify( db.get_global_properties(), []( global_property_object& gpo ) {
+      gpo.parameters.max_authority_depth = 2;
+   });
+   db.modify( romeo, [&]( account_object& a ) {
+      a.active = authority( 1, alpha_id, 1 );
+   });
+   db.modify( alpha, [&]( account_object& a ) {
+      a.active = authority( 1, bravo_id, 1 );
+   });
+   db.modify( bravo, [&]( account_object& a ) {
+      a.active = authority( 1, GRAPHENE_TEMP_ACCOUNT, 1 );
+   });
+
+   transfer_operation top;
+   top.from = romeo_id;
+   top.to = alpha_id;
+   top.amount = asset( 1 );
+   proposal_create_operation pop;
+   pop.fee_paying_account = alpha_id;
+   pop.expiration_time = db.head_block_time() + fc::days(1);
+   pop.proposed_ops.emplace_back( top );
+   trx.operations.push_back( pop );
+   const proposal_object& prop = db.get<proposal_object>(
+         PUSH_TX( db, trx, ~0 ).operation_results.front().get<object_id_type>() );
+   trx.clear();
+
+   const auto& tracker = db.get_proposal_authorization_index();
+   BOOST_CHECK( tracker.may_be_authorized( prop ) );
+   BOOST_CHECK( prop.is_authorized_to_execute( db ) );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -694,6 +694,27 @@ BOOST_AUTO_TEST_CASE( merkle_root )
    BOOST_CHECK( block.calculate_merkle_root() == c(dO) );
 }
 
+BOOST_AUTO_TEST_CASE( block_packed_size )
+{
+   clearable_block block;
+   BOOST_CHECK_EQUAL( block.get_packed_size(), fc::raw::pack_size( block ) );
+
+   for( uint32_t i = 0; i < 200; ++i )
+   {
+      processed_transaction tx;
+      tx.ref_block_prefix = i;
+      for( uint32_t j = 0; j < i % 3; ++j )
+      {
+         tx.operations.push_back( transfer_operation() );
+         tx.operation_results.push_back( void_result() );
+      }
+      tx.signatures.resize( i % 2 );
+      block.transactions.push_back( tx );
+   }
+   // 200 transactions need two bytes for the size of the vector
+   BOOST_CHECK_EQUAL( block.get_packed_size(), fc::raw::pack_size( block ) );
+}
+
 /**
  * Reproduces https://github.com/bitshares/bitshares-core/issues/888 and tests fix for it.
  */
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 Esher Project, and contributors.
+ *
+ * The MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/app/api.hpp>
+
+#include <fc/crypto/base64.hpp>
+#include <fc/crypto/hex.hpp>
+
+#include "../common/database_fixture.hpp"
+
+using namespace graphene::chain;
+using namespace graphene::chain::test;
+using namespace graphene::app;
+
+BOOST_FIXTURE_TEST_SUITE(block_api_tests, database_fixture)
+
+BOOST_AUTO_TEST_CASE( get_block_range_test )
+{ try {
+   ACTORS((alice));
+   transfer( committee_account, alice_id, asset(1000) );
+   generate_blocks( 5 );
+
+   block_api block_api1( app );
+   const uint32_t head_num = db.head_block_num();
+   BOOST_REQUIRE_GT( head_num, 3u );
+
+   BOOST_CHECK_THROW( block_api1.get_block_range( 0 ), fc::exception );
+   BOOST_CHECK_THROW( block_api1.get_block_range( 1, app.get_options().api_limit_get_block_range + 1 ),
+                      fc::exception );
+
+   // Full blocks as objects match get_blocks()
+   auto objects = block_api1.get_block_range( 1, 2 );
+   BOOST_REQUIRE_EQUAL( objects.blocks.size(), 2u );
+   BOOST_REQUIRE( objects.next_block_num.valid() );
+   BOOST_CHECK_EQUAL( *objects.next_block_num, 3u );
+   auto expected = block_api1.get_blocks( 1, 2 );
+   for( size_t i = 0; i < 2; ++i )
+   {
+      const auto& item = objects.blocks[i];
+      BOOST_CHECK_EQUAL( item.block_num, i + 1 );
+      BOOST_REQUIRE( item.block.valid() );
+      BOOST_REQUIRE( expected[i].valid() );
+      BOOST_CHECK( item.block->id() == expected[i]->id() );
+      BOOST_CHECK( item.block_id == expected[i]->id() );
+      BOOST_CHECK( !item.header.valid() );
+      BOOST_CHECK( !item.raw.valid() );
+   }
+
+   // Paging through the whole chain visits every block once
+   uint32_t next = 1;
+   uint32_t pages = 0;
+   uint32_t blocks = 0;
+   size_t transfers = 0;
+   while( true )
+   {
+      auto page = block_api1.get_block_range( next, 2, block_api::block_content::transaction_ids );
+      ++pages;
+      for( const auto& item : page.blocks )
+      {
+         BOOST_CHECK_EQUAL( item.block_num, blocks + 1 );
+         BOOST_REQUIRE( item.transaction_ids.valid() );
+         transfers += item.transaction_ids->size();
+         BOOST_CHECK( !item.block.valid() );
+         ++blocks;
+      }
+      if( !page.next_block_num.valid() )
+         break;
+      next = *page.next_block_num;
+   }
+   BOOST_CHECK_EQUAL( blocks, head_num );
+   BOOST_CHECK_EQUAL( pages, ( head_num + 1 ) / 2 );
+   BOOST_CHECK_GE( transfers, 2u ); // account creation and transfer
+
+   // Binary encodings unpack to the same block
+   const uint32_t last_num = head_num;
+   auto hex = block_api1.get_block_range( last_num, 5, block_api::block_content::full,
+                                          block_api::block_encoding::hex );
+   BOOST_REQUIRE_EQUAL( hex.blocks.size(), 1u );
+   BOOST_CHECK( !hex.next_block_num.valid() );
+   BOOST_REQUIRE( hex.blocks[0].raw.valid() );
+   vector<char> packed( hex.blocks[0].raw->size() / 2 );
+   fc::from_hex( *hex.blocks[0].raw, packed.data(), packed.size() );
+   signed_block from_hex = fc::raw::unpack<signed_block>( packed );
+   BOOST_CHECK( from_hex.id() == db.head_block_id() );
+   BOOST_CHECK( hex.blocks[0].block_id == db.head_block_id() );
+
+   auto base64 = block_api1.get_block_range( last_num, 1, block_api::block_content::full,
+                                             block_api::block_encoding::base64 );
+   BOOST_REQUIRE_EQUAL( base64.blocks.size(), 1u );
+   BOOST_REQUIRE( base64.blocks[0].raw.valid() );
+   string decoded = fc::base64_decode( *base64.blocks[0].raw );
+   BOOST_CHECK( decoded == string( packed.begin(), packed.end() ) );
+
+   // Headers only
+   auto header = block_api1.get_block_range( last_num, 1, block_api::block_content::header );
+   BOOST_REQUIRE_EQUAL( header.blocks.size(), 1u );
+   BOOST_REQUIRE( header.blocks[0].header.valid() );
+   BOOST_CHECK( header.blocks[0].header->id() == db.head_block_id() );
+   BOOST_CHECK( !header.blocks[0].block.valid() );
+
+   auto raw_header = block_api1.get_block_range( last_num, 1, block_api::block_content::header,
+                                                 block_api::block_encoding::hex );
+   BOOST_REQUIRE( raw_header.blocks[0].raw.valid() );
+   BOOST_CHECK_EQUAL( *raw_header.blocks[0].raw, fc::to_hex( fc::raw::pack( *header.blocks[0].header ) ) );
+
+   // Past the head block
+   auto empty = block_api1.get_block_range( head_num + 1 );
+   BOOST_CHECK( empty.blocks.empty() );
+   BOOST_CHECK( !empty.next_block_num.valid() );
+
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -35,6 +35,9 @@
 #include <graphene/chain/hardfork.hpp>
 #include <graphene/chain/witness_schedule_object.hpp>
 #include <graphene/chain/witness_object.hpp>
+#include <graphene/chain/transaction_history_object.hpp>
+
+#include <graphene/net/core_messages.hpp>
 
 #include <graphene/utilities/tempdir.hpp>
 
@@ -125,8 +128,18 @@ BOOST_AUTO_TEST_CASE( block_database_test )
          auto blk = bdb.fetch_by_number( i+1 );
          FC_ASSERT( blk.valid() );
          FC_ASSERT( blk->witness == witness_id_type(blk->block_num()) );
+         auto raw = bdb.fetch_raw_by_number( i+1 );
+         FC_ASSERT( raw.valid() );
+         FC_ASSERT( *raw == fc::raw::pack( *blk ) );
       }
 
+      // An index entry which does not match the stored block is rejected by both fetches
+      block_id_type wrong_id = b.id();
+      wrong_id._hash[1] ^= 1;
+      bdb.store( wrong_id, b );
+      FC_ASSERT( !bdb.fetch_by_number( b.block_num() ).valid() );
+      FC_ASSERT( !bdb.fetch_raw_by_number( b.block_num() ).valid() );
+
    } catch (fc::exception& e) {
       edump((e.to_detail_string()));
       throw;
@@ -426,6 +439,7 @@ BOOST_AUTO_TEST_CASE( fork_blocks )
             good_block = b;
             b.transactions.emplace_back(signed_transaction());
             b.transactions.back().operations.emplace_back(transfer_operation());
+            b.clear_derived_data();
             b.sign( init_account_priv_key );
             BOOST_CHECK_EQUAL(b.block_num(), 15u + j);
             GRAPHENE_CHECK_THROW(PUSH_BLOCK( db1, b ), fc::exception);
@@ -565,6 +579,99 @@ BOOST_AUTO_TEST_CASE( out_of_order_blocks )
 }
  */
 
+BOOST_AUTO_TEST_CASE( fork_db_ancestors_and_memory_limit )
+{
+   try {
+      fork_database fdb;
+      vector<signed_block> main_chain( 1 );
+      fdb.start_block( main_chain.back() );
+      for( uint32_t i = 0; i < 99; ++i )
+      {
+         signed_block b;
+         b.previous = main_chain.back().id();
+         main_chain.push_back( b );
+         fdb.push_block( b );
+      }
+      BOOST_REQUIRE_EQUAL( fdb.head()->num, 100u );
+
+      // a shorter fork branching off after block 50
+      vector<signed_block> side_chain;
+      side_chain.push_back( main_chain[49] );
+      for( uint32_t i = 0; i < 30; ++i )
+      {
+         signed_block b;
+         b.previous = side_chain.back().id();
+         b.timestamp = fc::time_point_sec( 1 );
+         side_chain.push_back( b );
+         fdb.push_block( b );
+      }
+      BOOST_CHECK( fdb.head()->id == main_chain.back().id() );
+
+      for( uint32_t num : { 1u, 2u, 17u, 50u, 64u, 99u, 100u } )
+         BOOST_CHECK( fork_database::fetch_ancestor( fdb.head(), num )->id == main_chain[num - 1].id() );
+      BOOST_CHECK( !fork_database::fetch_ancestor( fdb.head(), 101 ) );
+
+      const block_id_type side_head = side_chain.back().id();
+      BOOST_CHECK( fork_database::fetch_ancestor( fdb.fetch_block( side_head ), 51 )->id == side_chain[1].id() );
+      BOOST_CHECK( fdb.fetch_common_ancestor( fdb.head()->id, side_head )->id == main_chain[49].id() );
+      BOOST_CHECK( fdb.fetch_common_ancestor( side_head, main_chain[70].id() )->id == main_chain[49].id() );
+      BOOST_CHECK( fdb.fetch_common_ancestor( fdb.head()->id, main_chain[20].id() )->id == main_chain[20].id() );
+      BOOST_CHECK( fdb.fetch_common_ancestor( side_head, side_head )->id == side_head );
+
+      fork_database_metrics metrics = fdb.get_metrics();
+      BOOST_CHECK_EQUAL( metrics.items, 130u );
+      BOOST_CHECK_GT( metrics.memory_usage, 130u * sizeof(fork_item) );
+      BOOST_CHECK_EQUAL( metrics.pruned_items, 0u );
+
+      // the limit drops the side fork but never the branch of the head block
+      fdb.set_max_memory( 1 );
+      metrics = fdb.get_metrics();
+      BOOST_CHECK_EQUAL( metrics.items, 100u );
+      BOOST_CHECK_EQUAL( metrics.pruned_items, 30u );
+      BOOST_CHECK( !fdb.is_known_block( side_chain[1].id() ) );
+      BOOST_CHECK( !fdb.is_known_block( side_head ) );
+      for( const signed_block& b : main_chain )
+         BOOST_CHECK( fdb.is_known_block( b.id() ) );
+
+      // a block on an old fork is kept while it is the block being pushed
+      signed_block late_fork_block;
+      late_fork_block.previous = main_chain[80].id();
+      late_fork_block.timestamp = fc::time_point_sec( 2 );
+      fdb.push_block( late_fork_block );
+      BOOST_CHECK( fdb.is_known_block( late_fork_block.id() ) );
+      BOOST_CHECK_EQUAL( fdb.get_metrics().pruned_items, 30u );
+
+      // a fork within the undo window is kept while the memory is over the limit, and wins once it is longer
+      vector<signed_block> late_fork;
+      late_fork.push_back( main_chain[94] );
+      for( uint32_t i = 0; i < 7; ++i )
+      {
+         signed_block b;
+         b.previous = late_fork.back().id();
+         b.timestamp = fc::time_point_sec( 3 );
+         late_fork.push_back( b );
+         fdb.push_block( b );
+         BOOST_CHECK( fdb.is_known_block( b.id() ) );
+      }
+      BOOST_CHECK_EQUAL( fdb.head()->num, 102u );
+      BOOST_CHECK( fdb.head()->id == late_fork.back().id() );
+      BOOST_CHECK_GT( fdb.get_metrics().memory_usage, 1u );
+      // the previous head branch is still in the undo window, the old fork is dropped
+      for( uint32_t num = 95; num <= 100; ++num )
+         BOOST_CHECK( fdb.is_known_block( main_chain[num - 1].id() ) );
+      BOOST_CHECK( !fdb.is_known_block( late_fork_block.id() ) );
+      BOOST_CHECK_EQUAL( fdb.get_metrics().pruned_items, 31u );
+
+      signed_block unlinkable;
+      unlinkable.previous = side_head;
+      BOOST_CHECK_THROW( fdb.push_block( unlinkable ), fc::exception );
+      BOOST_CHECK_EQUAL( fdb.get_metrics().unlinkable_blocks, 1u );
+
+      fdb.reset();
+      BOOST_CHECK_EQUAL( fdb.get_metrics().memory_usage, 0u );
+   } FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_CASE( undo_pending )
 {
    try {
@@ -1949,4 +2056,476 @@ BOOST_FIXTURE_TEST_CASE( block_size_test, database_fixture )
    }
 }
 
+
+/// Hashes the packed contents of every object index, used to compare chain states
+static fc::sha256 hash_object_state( const database& db )
+{
+   fc::sha256::encoder enc;
+   for( uint8_t space = 0; space < 8; ++space )
+   {
+      for( uint8_t type = 0; type < 64; ++type )
+      {
+         const index* idx = nullptr;
+         try
+         {
+            idx = &db.get_index( space, type );
+         }
+         catch( const fc::exception& )
+         {
+            continue;
+         }
+         idx->inspect_all_objects( [&enc]( const object& o ) {
+            fc::raw::pack( enc, o.id );
+            const auto packed = o.pack();
+            enc.write( packed.data(), packed.size() );
+         });
+      }
+   }
+   return enc.result();
+}
+
+BOOST_FIXTURE_TEST_CASE( generated_block_state_reuse_test, database_fixture )
+{
+   try
+   {
+      ACTORS((alice)(bob));
+
+      const auto& uia = create_user_issued_asset( "REUSE" );
+      const asset_id_type uia_id = uia.get_id();
+      issue_uia( bob, uia.amount( 100000 ) );
+      fund( alice, asset( 10000000 ) );
+      generate_block();
+
+      const auto block_interval = db.get_global_properties().parameters.block_interval;
+      auto make_tx = [&]( const operation& op ) {
+         signed_transaction tx;
+         tx.operations.push_back( op );
+         tx.set_expiration( db.head_block_time() + fc::seconds( 100 * block_interval ) );
+         return tx;
+      };
+
+      transfer_operation xfer_op;
+      xfer_op.from = alice_id;
+      xfer_op.to = bob_id;
+      xfer_op.amount = asset( 1000 );
+
+      vector<signed_transaction> txs;
+      txs.push_back( make_tx( xfer_op ) );
+      txs.push_back( make_tx( make_limit_order_create_op( alice_id, asset( 3000 ), asset( 300, uia_id ) ) ) );
+      txs.push_back( make_tx( make_limit_order_create_op( bob_id, asset( 200, uia_id ), asset( 1000 ) ) ) );
+      txs.push_back( make_tx( make_account( "carol" ) ) );
+
+      // Generates the same block once with the reused state and once through the regular push_block path,
+      // then checks that both blocks and the resulting states are identical
+      auto compare_paths = [&]( uint32_t miss_blocks ) {
+         for( const auto& tx : txs )
+            PUSH_TX( db, tx, ~0 );
+         const signed_block reused_block = generate_block( ~0, init_account_priv_key, miss_blocks );
+         const fc::sha256 reused_state = hash_object_state( db );
+         BOOST_CHECK_EQUAL( reused_block.transactions.size(), txs.size() );
+
+         db.pop_block();
+         db._popped_tx.clear();
+         db.clear_pending();
+
+         db.enable_generated_block_state_reuse( false );
+         for( const auto& tx : txs )
+            PUSH_TX( db, tx, ~0 );
+         const signed_block pushed_block = generate_block( ~0, init_account_priv_key, miss_blocks );
+         const fc::sha256 pushed_state = hash_object_state( db );
+         db.enable_generated_block_state_reuse( true );
+
+         BOOST_CHECK( reused_block.id() == pushed_block.id() );
+         BOOST_CHECK( reused_state == pushed_state );
+         BOOST_CHECK( db.head_block_id() == pushed_block.id() );
+      };
+
+      BOOST_TEST_MESSAGE( "Comparing a regular block" );
+      compare_paths( 0 );
+
+      BOOST_TEST_MESSAGE( "Comparing a maintenance block" );
+      const auto& dgp = db.get_dynamic_global_properties();
+      generate_blocks( dgp.next_maintenance_time - block_interval );
+      const fc::time_point_sec maintenance_time = dgp.next_maintenance_time;
+      txs.pop_back(); // the account name is taken now
+      for( auto& tx : txs )
+         tx.set_expiration( db.head_block_time() + fc::seconds( 100 * block_interval ) );
+      compare_paths( 0 );
+      BOOST_CHECK( db.head_block_time() >= maintenance_time );
+      BOOST_CHECK( dgp.next_maintenance_time > maintenance_time );
+   }
+   catch( fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_FIXTURE_TEST_CASE( block_derived_data_test, database_fixture )
+{
+   try
+   {
+      ACTORS((alice)(bob));
+      fund( alice, asset( 10000000 ) );
+
+      for( int i = 1; i <= 5; ++i )
+         transfer( alice_id, bob_id, asset( 1000 * i ) );
+      const signed_block blk = generate_block();
+      BOOST_REQUIRE_EQUAL( blk.transactions.size(), 5u );
+      const auto packed_block = fc::raw::pack( blk );
+
+      // Checks the derived data against the values calculated one by one on a fresh copy of the block
+      auto check_derived_data = [&packed_block]( const signed_block& b ) {
+         const auto fresh = fc::raw::unpack<signed_block>( packed_block );
+         const auto& derived = b.get_derived_data();
+         BOOST_REQUIRE_EQUAL( derived.transactions.size(), fresh.transactions.size() );
+         for( size_t i = 0; i < fresh.transactions.size(); ++i )
+         {
+            const processed_transaction& trx = fresh.transactions[i];
+            BOOST_CHECK( derived.transactions[i].id == trx.id() );
+            BOOST_CHECK_EQUAL( derived.transactions[i].packed_size, trx.get_packed_size() );
+            BOOST_CHECK( derived.transactions[i].merkle_digest == trx.merkle_digest() );
+            graphene::net::trx_message transaction_message( trx );
+            BOOST_CHECK( derived.transactions[i].message_id == graphene::net::message( transaction_message ).id() );
+            BOOST_CHECK( b.transactions[i].id() == trx.id() );
+            BOOST_CHECK_EQUAL( b.transactions[i].get_packed_size(), trx.get_packed_size() );
+         }
+         BOOST_CHECK( b.calculate_merkle_root() == fresh.transaction_merkle_root );
+      };
+
+      BOOST_TEST_MESSAGE( "Calculating the derived data on first use" );
+      check_derived_data( fc::raw::unpack<signed_block>( packed_block ) );
+
+      BOOST_TEST_MESSAGE( "Calculating the derived data while precomputing the block" );
+      const uint32_t skip_serial = database::skip_transaction_signatures | database::skip_witness_signature
+                                   | database::skip_merkle_check | database::skip_transaction_dupe_check;
+      for( uint32_t skip : { (uint32_t)database::skip_nothing, skip_serial } )
+      {
+         const auto b = fc::raw::unpack<signed_block>( packed_block );
+         db.precompute_parallel( b, skip ).wait();
+         check_derived_data( b );
+
+         // Copies of the block share the derived data
+         const signed_block copy = b;
+         BOOST_CHECK( &copy.get_derived_data() == &b.get_derived_data() );
+      }
+
+      BOOST_TEST_MESSAGE( "Modifying a transaction without changing the number of transactions" );
+      auto b = fc::raw::unpack<signed_block>( packed_block );
+      const auto old_id = b.get_derived_data().transactions[0].id;
+      const auto old_root = b.calculate_merkle_root();
+      b.transactions[0].expiration += 1;
+      b.transactions[0].operation_results.clear();
+      b.clear_derived_data();
+      const auto& derived = b.get_derived_data();
+      const auto fresh_trx = fc::raw::unpack<processed_transaction>( fc::raw::pack( b.transactions[0] ) );
+      BOOST_CHECK( derived.transactions[0].id != old_id );
+      BOOST_CHECK( derived.transactions[0].id == fresh_trx.id() );
+      BOOST_CHECK( derived.transactions[0].merkle_digest == fresh_trx.merkle_digest() );
+      BOOST_CHECK_EQUAL( b.get_packed_size(), fc::raw::pack_size( b ) );
+      BOOST_CHECK( b.calculate_merkle_root() != old_root );
+
+      BOOST_TEST_MESSAGE( "Adding a transaction without clearing the derived data" );
+      b.transactions.push_back( b.transactions.back() );
+      BOOST_CHECK_THROW( b.get_derived_data(), fc::exception );
+   }
+   catch( fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_FIXTURE_TEST_CASE( recent_transaction_cache_test, database_fixture )
+{
+   try
+   {
+      ACTORS((alice)(bob));
+      fund( alice, asset( 10000000 ) );
+
+      transfer_operation op;
+      op.from = alice_id;
+      op.to = bob_id;
+      op.amount = asset( 1000 );
+      signed_transaction tx;
+      tx.operations.push_back( op );
+      set_expiration( db, tx );
+      sign( tx, alice_private_key );
+      PUSH_TX( db, tx );
+      const transaction_id_type tx_id = tx.id();
+
+      // The dupe-check object does not keep the transaction itself
+      const auto& dupe_idx = db.get_index_type<transaction_index>().indices().get<by_trx_id>();
+      auto itr = dupe_idx.find( tx_id );
+      BOOST_REQUIRE( itr != dupe_idx.end() );
+      BOOST_CHECK( itr->expiration == tx.expiration );
+      BOOST_CHECK( db.get_recent_transaction( tx_id ).id() == tx_id );
+
+      generate_block();
+      BOOST_CHECK( db.get_recent_transaction( tx_id ).id() == tx_id );
+
+      // A popped transaction is no longer recent even though the cache still holds it
+      db.pop_block();
+      db._popped_tx.clear();
+      db.clear_pending();
+      BOOST_CHECK( !db.is_known_transaction( tx_id ) );
+      GRAPHENE_CHECK_THROW( db.get_recent_transaction( tx_id ), fc::exception );
+
+      PUSH_TX( db, tx );
+      generate_block();
+      BOOST_CHECK( db.get_recent_transaction( tx_id ).id() == tx_id );
+
+      generate_blocks( tx.expiration + db.get_global_properties().parameters.block_interval );
+      BOOST_CHECK( !db.is_known_transaction( tx_id ) );
+      GRAPHENE_CHECK_THROW( db.get_recent_transaction( tx_id ), fc::exception );
+
+      BOOST_TEST_MESSAGE( "Checking the size limit and expiration of the cache" );
+      recent_transaction_cache cache;
+      vector<signed_transaction> txs;
+      for( uint32_t i = 0; i < 10; ++i )
+      {
+         signed_transaction t = tx;
+         t.expiration = fc::time_point_sec( 1000 + i );
+         txs.push_back( t );
+         cache.add( t.id(), t );
+      }
+      const uint64_t packed_size = fc::raw::pack_size( txs[0] );
+      BOOST_CHECK_EQUAL( cache.packed_size(), 10 * packed_size );
+      BOOST_REQUIRE( cache.find( txs[3].id() ).valid() );
+      BOOST_CHECK( cache.find( txs[3].id() )->id() == txs[3].id() );
+
+      // Adding a transaction again replaces it, e.g. with other signatures, and makes it the latest one
+      signed_transaction resigned = txs[0];
+      resigned.signatures.push_back( resigned.signatures.front() );
+      cache.add( resigned.id(), resigned );
+      BOOST_CHECK_EQUAL( cache.size(), 10u );
+      const uint64_t resigned_size = fc::raw::pack_size( resigned );
+      BOOST_CHECK_EQUAL( cache.packed_size(), 9 * packed_size + resigned_size );
+      BOOST_REQUIRE( cache.find( txs[0].id() ).valid() );
+      BOOST_CHECK_EQUAL( cache.find( txs[0].id() )->signatures.size(), 2u );
+
+      cache.set_max_size( 5 * packed_size + resigned_size );
+      BOOST_CHECK_EQUAL( cache.size(), 6u );
+      BOOST_CHECK( !cache.find( txs[4].id() ).valid() );
+      BOOST_CHECK( cache.find( txs[5].id() ).valid() );
+      BOOST_CHECK( cache.find( txs[0].id() ).valid() );
+
+      cache.remove_expired( fc::time_point_sec( 1007 ) );
+      BOOST_CHECK_EQUAL( cache.size(), 3u );
+      BOOST_CHECK_EQUAL( cache.packed_size(), 3 * packed_size );
+      BOOST_CHECK( !cache.find( txs[6].id() ).valid() );
+      BOOST_CHECK( cache.find( txs[7].id() ).valid() );
+   }
+   catch( fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_FIXTURE_TEST_CASE( recent_transactions_evicted_from_cache, database_fixture )
+{
+   try
+   {
+      ACTORS((alice)(bob));
+      fund( alice, asset( 10000000 ) );
+      generate_block();
+
+      // Nothing stays in the cache
+      db.set_recent_transaction_cache_size( 0 );
+
+      transfer_operation op;
+      op.from = alice_id;
+      op.to = bob_id;
+      op.amount = asset( 1000 );
+      signed_transaction tx;
+      tx.operations.push_back( op );
+      set_expiration( db, tx );
+      sign( tx, alice_private_key );
+      PUSH_TX( db, tx );
+      const transaction_id_type tx_id = tx.id();
+      generate_block();
+
+      const auto& dupe_idx = db.get_index_type<transaction_index>().indices().get<by_trx_id>();
+      auto itr = dupe_idx.find( tx_id );
+      BOOST_REQUIRE( itr != dupe_idx.end() );
+      const object_id_type history_id = itr->id;
+      BOOST_CHECK_EQUAL( itr->block_num, db.head_block_num() );
+      BOOST_CHECK( itr->impacted_accounts.find( alice_id ) != itr->impacted_accounts.end() );
+      BOOST_CHECK( itr->impacted_accounts.find( bob_id ) != itr->impacted_accounts.end() );
+
+      // The transaction is fetched from its block
+      BOOST_CHECK( db.get_recent_transaction( tx_id ).id() == tx_id );
+
+      // The removal of the expired dupe-check object is still notified to the accounts of the transaction
+      bool removal_notified = false;
+      flat_set<account_id_type> removed_accounts;
+      auto connection = db.removed_objects.connect( [&]( const vector<object_id_type>& ids,
+                                                         const vector<const object*>&,
+                                                         const flat_set<account_id_type>& accounts ) {
+         if( std::find( ids.begin(), ids.end(), history_id ) == ids.end() )
+            return;
+         removal_notified = true;
+         removed_accounts = accounts;
+      });
+      generate_blocks( tx.expiration + db.get_global_properties().parameters.block_interval );
+      connection.disconnect();
+      BOOST_CHECK( !db.is_known_transaction( tx_id ) );
+      BOOST_REQUIRE( removal_notified );
+      BOOST_CHECK( removed_accounts.find( alice_id ) != removed_accounts.end() );
+      BOOST_CHECK( removed_accounts.find( bob_id ) != removed_accounts.end() );
+   }
+   catch( fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_CASE( recent_transactions_after_restart )
+{
+   try {
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+      auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(string("null_key")) );
+      signed_transaction trx;
+      {
+         database db;
+         db.open(data_dir.path(), make_genesis, "TEST");
+
+         account_create_operation cop;
+         cop.registrar = GRAPHENE_TEMP_ACCOUNT;
+         cop.name = "nathan";
+         cop.owner = authority(1, init_account_priv_key.get_public_key(), 1);
+         cop.active = cop.owner;
+         trx.operations.push_back(cop);
+         set_expiration( db, trx );
+         PUSH_TX( db, trx );
+         db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                           database::skip_nothing);
+         BOOST_CHECK( db.get_recent_transaction( trx.id() ).id() == trx.id() );
+
+         // Without rewinding, the block is not replayed when the database is opened again, and the transaction
+         // is fetched from the block when it is needed
+         db.close( false );
+      }
+      {
+         database db;
+         db.open(data_dir.path(), []{return genesis_state_type();}, "TEST");
+         BOOST_REQUIRE( db.is_known_transaction( trx.id() ) );
+         BOOST_CHECK( db.get_recent_transaction( trx.id() ).id() == trx.id() );
+         db.close();
+      }
+   } FC_LOG_AND_RETHROW()
+}
+
+BOOST_FIXTURE_TEST_CASE( expiration_schedule_test, database_fixture )
+{
+   try
+   {
+      using deadline_type = expiration_schedule::deadline_type;
+      ACTORS((alice));
+      fund( alice, asset( 10000000 ) );
+      const asset_id_type usd_id = create_user_issued_asset( "USDX" ).get_id();
+      generate_block();
+
+      const expiration_schedule& schedule = db.get_expiration_schedule();
+      const size_t initial_size = schedule.size();
+      const time_point_sec expiration = db.head_block_time() + 60;
+
+      // orders which never expire have no deadline
+      create_sell_order( alice_id, asset( 1000 ), asset( 100, usd_id ) );
+      BOOST_CHECK_EQUAL( schedule.size(), initial_size );
+
+      create_sell_order( alice_id, asset( 1000 ), asset( 100, usd_id ), expiration );
+      BOOST_CHECK_EQUAL( schedule.size(), initial_size + 1 );
+      generate_block();
+      BOOST_CHECK_EQUAL( schedule.size(), initial_size + 1 );
+      // the deadline goes away when the block is undone
+      db.pop_block();
+      db._popped_tx.clear();
+      db.clear_pending();
+      BOOST_CHECK_EQUAL( schedule.size(), initial_size );
+
+      const limit_order_id_type order_id
+            = create_sell_order( alice_id, asset( 1000 ), asset( 101, usd_id ), expiration )->get_id();
+      BOOST_CHECK_EQUAL( schedule.size(), initial_size + 1 );
+      BOOST_CHECK( !schedule.is_due( deadline_type::limit_order, expiration - 1 ) );
+      BOOST_CHECK( schedule.is_due( deadline_type::limit_order, expiration ) );
+      BOOST_CHECK( !schedule.is_due( deadline_type::htlc, expiration ) );
+
+      generate_block();
+      BOOST_CHECK( !schedule.any_due( db.head_block_time() ) );
+      BOOST_CHECK( db.find( order_id ) );
+
+      // the order is cancelled in the first block at its expiration and its deadline is removed
+      generate_blocks( expiration );
+      BOOST_CHECK( db.head_block_time() >= expiration );
+      BOOST_CHECK( !db.find( order_id ) );
+      BOOST_CHECK( !schedule.is_due( deadline_type::limit_order, db.head_block_time() ) );
+      BOOST_CHECK_EQUAL( schedule.size(), initial_size );
+   }
+   catch( fc::exception& e )
+   {
+      edump((e.to_detail_string()));
+      throw;
+   }
+}
+
+BOOST_AUTO_TEST_CASE( expiration_schedule_after_restart )
+{
+   try {
+      using deadline_type = expiration_schedule::deadline_type;
+      fc::temp_directory data_dir( graphene::utilities::temp_directory_path() );
+      auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(string("null_key")) );
+      proposal_id_type proposal_id;
+      time_point_sec expiration;
+      size_t schedule_size = 0;
+      {
+         database db;
+         db.open(data_dir.path(), make_genesis, "TEST");
+         db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                           database::skip_nothing);
+
+         const size_t initial_size = db.get_expiration_schedule().size();
+         expiration = db.head_block_time() + 60;
+         transfer_operation transfer;
+         transfer.from = GRAPHENE_TEMP_ACCOUNT;
+         transfer.to = account_id_type(1);
+         transfer.amount = asset( 1 );
+         proposal_create_operation pop;
+         pop.fee_paying_account = GRAPHENE_TEMP_ACCOUNT;
+         pop.expiration_time = expiration;
+         pop.proposed_ops.emplace_back( transfer );
+         signed_transaction trx;
+         trx.operations.push_back( pop );
+         set_expiration( db, trx );
+         processed_transaction ptx = PUSH_TX( db, trx );
+         proposal_id = proposal_id_type( ptx.operation_results[0].get<object_id_type>() );
+         db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                           database::skip_nothing);
+         schedule_size = db.get_expiration_schedule().size();
+         BOOST_CHECK_EQUAL( schedule_size, initial_size + 1 );
+
+         // Without rewinding, the proposal is loaded from disk instead of being created again by a replay
+         db.close( false );
+      }
+      {
+         database db;
+         db.open(data_dir.path(), []{return genesis_state_type();}, "TEST");
+         const expiration_schedule& schedule = db.get_expiration_schedule();
+         BOOST_REQUIRE( db.find( proposal_id ) );
+         BOOST_CHECK_EQUAL( schedule.size(), schedule_size );
+         BOOST_CHECK( !schedule.is_due( deadline_type::proposal, expiration - 1 ) );
+         BOOST_CHECK( schedule.is_due( deadline_type::proposal, expiration ) );
+
+         while( db.head_block_time() < expiration )
+            db.generate_block(db.get_slot_time(1), db.get_scheduled_witness(1), init_account_priv_key,
+                              database::skip_nothing);
+         BOOST_CHECK( !db.find( proposal_id ) );
+         BOOST_CHECK_EQUAL( schedule.size(), schedule_size - 1 );
+         db.close();
+      }
+   } FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -345,4 +345,79 @@ BOOST_AUTO_TEST_CASE( call_order_object_test )
 
 } FC_CAPTURE_LOG_AND_RETHROW( (0) ) }
 
+BOOST_AUTO_TEST_CASE( call_order_collateral_index_test )
+{ try {
+   // the orders are only used for indexing, so the assets and accounts do not need to exist
+   const asset_id_type core_id;
+   const asset_id_type usd_id( 1 );
+   const asset_id_type eur_id( 2 );
+
+   std::mt19937 gen( 2481 );
+   std::uniform_int_distribution<int64_t> small_amount( 1, 1000 ); // lots of equal ratios
+   std::uniform_int_distribution<int64_t> large_amount( 1, GRAPHENE_MAX_SHARE_SUPPLY );
+   auto random_amount = [&]() { return ( gen() % 2 ) ? small_amount( gen ) : large_amount( gen ); };
+
+   auto check = [&]() {
+      const auto& by_collateral = db.get_index_type<call_order_index>().indices().get<by_collateral>();
+      for( const asset_id_type debt_id : { usd_id, eur_id } )
+      {
+         vector<object_id_type> expected;
+         for( auto itr = by_collateral.lower_bound( price::min( core_id, debt_id ) );
+              itr != by_collateral.end() && itr->debt_type() == debt_id; ++itr )
+            expected.push_back( itr->id );
+         vector<object_id_type> actual;
+         for( const auto& e : db.get_call_orders_by_collateral().get_call_orders( debt_id, core_id ) )
+         {
+            BOOST_CHECK( e.order->id == e.id );
+            actual.push_back( e.id );
+         }
+         BOOST_CHECK_EQUAL( expected.size(), actual.size() );
+         BOOST_CHECK( expected == actual );
+      }
+   };
+
+   vector<call_order_id_type> ids;
+   for( uint32_t i = 0; i < 300; ++i )
+   {
+      const asset_id_type debt_id = ( i % 2 ) ? usd_id : eur_id;
+      ids.push_back( db.create<call_order_object>( [&]( call_order_object& o ) {
+         o.borrower = account_id_type( i );
+         o.collateral = random_amount();
+         o.debt = random_amount();
+         o.call_price = price( asset( 1, core_id ), asset( 1, debt_id ) );
+      }).get_id() );
+   }
+   check();
+
+   auto modify_some = [&]() {
+      for( size_t i = 0; i < ids.size(); i += 3 )
+      {
+         const call_order_object* o = db.find( ids[i] );
+         if( o != nullptr )
+            db.modify( *o, [&]( call_order_object& obj ) {
+               obj.collateral = random_amount();
+               obj.debt = random_amount();
+            });
+      }
+      for( size_t i = 1; i < ids.size(); i += 5 )
+      {
+         const call_order_object* o = db.find( ids[i] );
+         if( o != nullptr )
+            db.remove( *o );
+      }
+   };
+
+   modify_some();
+   check();
+
+   // changes which are undone are undone in the index too
+   {
+      auto session = db._undo_db.start_undo_session();
+      modify_some();
+      check();
+   }
+   check();
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -28,8 +28,12 @@
 
 #include <graphene/chain/account_object.hpp>
 #include <graphene/chain/proposal_object.hpp>
+#include <graphene/chain/hardfork.hpp>
 
 #include <fc/crypto/digest.hpp>
+#include <fc/thread/thread.hpp>
+
+#include <atomic>
 
 #include "../common/database_fixture.hpp"
 
@@ -311,4 +315,317 @@ BOOST_AUTO_TEST_CASE( required_approval_index_test ) // see https://github.com/b
 
 } FC_LOG_AND_RETHROW() }
 
+BOOST_AUTO_TEST_CASE( read_only_block_observer_test )
+{ try {
+   ACTORS((alice));
+   generate_block();
+
+   // Only accessed by the observer, or after waiting for it
+   vector<uint32_t> block_nums;
+   size_t transfers = 0;
+   size_t new_objects = 0;
+   size_t transfer_results = 0;
+   db.add_read_only_block_observer( [&]( const applied_block_record& record ) {
+      block_nums.push_back( record.block.block_num() );
+      // The results are kept next to the block, one entry per transaction and operation
+      if( record.operation_results.size() != record.block.transactions.size() )
+         return;
+      for( size_t i = 0; i < record.block.transactions.size(); ++i )
+      {
+         const auto& ops = record.block.transactions[i].operations;
+         for( size_t j = 0; j < ops.size() && j < record.operation_results[i].size(); ++j )
+         {
+            if( ops[j].is_type<transfer_operation>() )
+               ++transfer_results;
+         }
+      }
+      for( const auto& op : record.applied_operations )
+      {
+         if( op.valid() && op->op.is_type<transfer_operation>() )
+            ++transfers;
+      }
+      new_objects += record.new_object_ids.size();
+   } );
+
+   transfer( committee_account, alice_id, asset(1000) );
+   generate_block();
+   db.wait_for_read_only_block_observers();
+
+   BOOST_REQUIRE_EQUAL( block_nums.size(), 1u );
+   BOOST_CHECK_EQUAL( block_nums.front(), db.head_block_num() );
+   BOOST_CHECK_EQUAL( transfers, 1u );
+   BOOST_CHECK_EQUAL( transfer_results, 1u );
+   BOOST_CHECK_GT( new_objects, 0u );
+
+   generate_blocks( 3 );
+   db.wait_for_read_only_block_observers();
+
+   BOOST_REQUIRE_EQUAL( block_nums.size(), 4u );
+   for( size_t i = 1; i < block_nums.size(); ++i )
+      BOOST_CHECK_EQUAL( block_nums[i], block_nums[i-1] + 1 );
+   BOOST_CHECK_EQUAL( transfers, 1u );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( read_only_block_observer_exception_test )
+{ try {
+   generate_block();
+
+   // Only accessed by the observer, or after waiting for it
+   vector<uint32_t> block_nums;
+   db.add_read_only_block_observer( [&]( const applied_block_record& record ) {
+      block_nums.push_back( record.block.block_num() );
+      throw std::runtime_error( "observer failure" );
+   } );
+
+   // Exceptions of observers are logged and neither reach block application nor stop later notifications
+   const uint32_t first_block_num = db.head_block_num() + 1;
+   generate_blocks( 3 );
+   db.wait_for_read_only_block_observers();
+
+   BOOST_CHECK_EQUAL( db.head_block_num(), first_block_num + 2 );
+   BOOST_REQUIRE_EQUAL( block_nums.size(), 3u );
+   for( size_t i = 0; i < block_nums.size(); ++i )
+      BOOST_CHECK_EQUAL( block_nums[i], first_block_num + i );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( applied_operation_log_test )
+{ try {
+   applied_operation_log log;
+   BOOST_CHECK( log.empty() );
+   BOOST_CHECK_EQUAL( log.capacity(), 0u );
+
+   transfer_operation op;
+   for( int64_t i = 0; i < 300; ++i )
+   {
+      op.amount = asset( i );
+      log.append( op ).block_num = static_cast<uint32_t>( i );
+   }
+   BOOST_REQUIRE_EQUAL( log.size(), 300u );
+   const size_t capacity = log.capacity();
+   BOOST_CHECK_GE( capacity, 300u );
+   const operation_history_object* first = &*log[0];
+
+   // Entries are not moved while the log grows
+   uint32_t count = 0;
+   for( const auto& entry : log )
+   {
+      BOOST_REQUIRE( entry.valid() );
+      BOOST_CHECK_EQUAL( entry->block_num, count );
+      BOOST_CHECK_EQUAL( entry->op.get<transfer_operation>().amount.amount.value, count );
+      ++count;
+   }
+   BOOST_CHECK_EQUAL( count, 300u );
+
+   // Failed operations are reset or truncated
+   log[100].reset();
+   log.truncate( 200 );
+   BOOST_CHECK_EQUAL( log.size(), 200u );
+   count = 0;
+   for( const auto& entry : log )
+   {
+      if( entry.valid() )
+         ++count;
+   }
+   BOOST_CHECK_EQUAL( count, 199u );
+
+   // The memory is reused by the next block
+   log.clear();
+   BOOST_CHECK( log.empty() );
+   BOOST_CHECK_EQUAL( log.capacity(), capacity );
+   op.amount = asset( 1000 );
+   log.append( op );
+   BOOST_CHECK( &*log[0] == first );
+   BOOST_CHECK_EQUAL( log[0]->op.get<transfer_operation>().amount.amount.value, 1000 );
+   BOOST_CHECK_EQUAL( log[0]->block_num, 0u );
+
+   // Moving hands over the entries
+   applied_operation_log moved( std::move( log ) );
+   BOOST_CHECK_EQUAL( moved.size(), 1u );
+   BOOST_CHECK( log.empty() );
+   BOOST_CHECK_EQUAL( log.capacity(), 0u );
+   log.append( op );
+   BOOST_CHECK_EQUAL( log.size(), 1u );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( apply_profiler_test )
+{ try {
+   ACTORS((alice));
+   generate_block();
+
+   BOOST_CHECK( db.get_apply_profiler() == nullptr );
+   db.enable_apply_profiler( true );
+   BOOST_REQUIRE( db.get_apply_profiler() != nullptr );
+
+   transfer( committee_account, alice_id, asset(1000) );
+   generate_block();
+
+   auto find_operation = []( const apply_profile& profile, const string& name ) {
+      return std::find_if( profile.operations.begin(), profile.operations.end(),
+                           [&name]( const operation_latency_stats& s ) { return s.operation == name; } );
+   };
+   auto find_step = []( const apply_profile& profile, const string& name ) {
+      return std::find_if( profile.block_steps.begin(), profile.block_steps.end(),
+                           [&name]( const block_step_latency_stats& s ) { return s.step == name; } );
+   };
+
+   apply_profile profile = db.get_apply_profiler()->get_profile();
+   // The transfer is applied when pushed and when the block is generated, the generated state is then reused
+   auto transfer_stats = find_operation( profile, "transfer_operation" );
+   BOOST_REQUIRE( transfer_stats != profile.operations.end() );
+   BOOST_CHECK_GE( transfer_stats->total.count, 2u );
+   BOOST_CHECK_EQUAL( transfer_stats->evaluate.count, transfer_stats->total.count );
+   BOOST_CHECK_EQUAL( transfer_stats->apply.count, transfer_stats->total.count );
+   // Fees are handled in both evaluate and apply
+   BOOST_CHECK_EQUAL( transfer_stats->fee.count, 2 * transfer_stats->total.count );
+   BOOST_CHECK_GE( transfer_stats->total.total_ns, transfer_stats->apply.total_ns );
+   uint64_t bucketed = 0;
+   for( uint64_t n : transfer_stats->total.buckets )
+      bucketed += n;
+   BOOST_CHECK_EQUAL( bucketed, transfer_stats->total.count );
+   BOOST_CHECK( find_operation( profile, "account_create_operation" ) == profile.operations.end() );
+
+   auto orders_step = find_step( profile, "clear_expired_orders" );
+   BOOST_REQUIRE( orders_step != profile.block_steps.end() );
+   BOOST_CHECK_EQUAL( orders_step->histogram.count, 1u );
+   BOOST_CHECK( find_step( profile, "perform_chain_maintenance" ) == profile.block_steps.end() );
+
+   generate_blocks( db.get_dynamic_global_properties().next_maintenance_time );
+   profile = db.get_apply_profiler()->get_profile();
+   auto maint_step = find_step( profile, "perform_chain_maintenance" );
+   BOOST_REQUIRE( maint_step != profile.block_steps.end() );
+   BOOST_CHECK_GE( maint_step->histogram.count, 1u );
+
+   db.get_apply_profiler()->reset();
+   profile = db.get_apply_profiler()->get_profile();
+   BOOST_CHECK( profile.operations.empty() );
+   BOOST_CHECK( profile.block_steps.empty() );
+
+   db.enable_apply_profiler( false );
+   BOOST_CHECK( db.get_apply_profiler() == nullptr );
+   generate_block();
+} FC_LOG_AND_RETHROW() }
+
+
+BOOST_AUTO_TEST_CASE( read_only_threads_test )
+{ try {
+   ACTORS( (alice) );
+   generate_block();
+
+   const fc::thread* caller = &fc::thread::current();
+   // Without worker threads the calls run on the calling thread
+   BOOST_CHECK( db.run_read_only( []() { return &fc::thread::current(); } ) == caller );
+
+   db.set_read_only_threads( 2 );
+   const uint32_t head_num = db.head_block_num();
+   for( int i = 0; i < 4; ++i )
+   {
+      const fc::thread* worker = nullptr;
+      const fc::thread* nested = nullptr;
+      bool reading = false;
+      const uint32_t result = db.run_read_only( [&]() {
+         worker = &fc::thread::current();
+         reading = chain_state_lock::is_reading_task();
+         // Nested calls run directly on the worker thread
+         nested = db.run_read_only( []() { return &fc::thread::current(); } );
+         return db.head_block_num();
+      });
+      BOOST_CHECK_EQUAL( result, head_num );
+      BOOST_CHECK( worker != caller );
+      BOOST_CHECK( nested == worker );
+      BOOST_CHECK( reading );
+   }
+   BOOST_CHECK( !chain_state_lock::is_reading_task() );
+
+   // Exceptions are passed to the caller
+   BOOST_CHECK_THROW( db.run_read_only( []() -> int { FC_THROW( "read-only failure" ); } ), fc::exception );
+
+   // Blocks can still be applied after read-only calls have finished
+   transfer( committee_account, alice_id, asset( 1000 ) );
+   generate_block();
+   BOOST_CHECK_EQUAL( db.run_read_only( [this]() { return db.head_block_num(); } ), head_num + 1 );
+   BOOST_CHECK_EQUAL( db.run_read_only( [this,alice_id]() { return db.get_balance( alice_id, asset_id_type() ); } )
+                        .amount.value, 1000 );
+
+   db.set_read_only_threads( 0 );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( chain_state_lock_test )
+{ try {
+   chain_state_lock state_lock;
+   BOOST_CHECK( !state_lock.is_writing_task() );
+
+   state_lock.lock_exclusive();
+   {
+      // The exclusive lock is recursive for the writing task
+      chain_state_lock::write_guard inner( state_lock );
+      BOOST_CHECK( state_lock.is_writing_task() );
+   }
+   BOOST_CHECK( state_lock.is_writing_task() );
+
+   // Readers on other threads wait until the writer is done
+   std::atomic<bool> read { false };
+   fc::thread reader_thread( "reader" );
+   fc::future<void> reader = reader_thread.async( [&state_lock,&read]() {
+      chain_state_lock::read_guard guard( state_lock );
+      read = chain_state_lock::is_reading_task();
+   }, "reader" );
+   fc::usleep( fc::milliseconds( 50 ) );
+   BOOST_CHECK( !read );
+
+   // Other tasks on the writing thread are not recursive holders, and wait without blocking the thread
+   bool written = false;
+   fc::future<void> writer = fc::async( [&state_lock,&written]() {
+      chain_state_lock::write_guard guard( state_lock );
+      written = state_lock.is_writing_task();
+   }, "writer" );
+   fc::usleep( fc::milliseconds( 50 ) );
+   BOOST_CHECK( !written );
+   BOOST_CHECK( !read );
+
+   state_lock.unlock_exclusive();
+   BOOST_CHECK( !state_lock.is_writing_task() );
+   writer.wait();
+   reader.wait();
+   BOOST_CHECK( written );
+   BOOST_CHECK( read );
+   BOOST_CHECK( !state_lock.is_writing_task() );
+   BOOST_CHECK( !chain_state_lock::is_reading_task() );
+} FC_LOG_AND_RETHROW() }
+
+BOOST_AUTO_TEST_CASE( hardfork_state_test )
+{ try {
+   auto check = [this]() {
+      const auto& dgp = db.get_dynamic_global_properties();
+      const hardfork_state expected( dgp.time, dgp.next_maintenance_time );
+      const hardfork_state& hf = db.get_hardfork_state();
+      for( uint8_t i = 0; i < hardfork_state::HARDFORK_COUNT; ++i )
+      {
+         const auto type = static_cast<hardfork_state::hardfork>( i );
+         BOOST_CHECK_EQUAL( hf.passed( type ), expected.passed( type ) );
+      }
+      BOOST_CHECK_EQUAL( hf.core_460_passed(), dgp.next_maintenance_time >= HARDFORK_CORE_460_TIME );
+      BOOST_CHECK_EQUAL( hf.core_1270_passed(), dgp.next_maintenance_time > HARDFORK_CORE_1270_TIME );
+      BOOST_CHECK_EQUAL( hf.core_2481_passed(), HARDFORK_CORE_2481_PASSED( dgp.next_maintenance_time ) );
+      BOOST_CHECK_EQUAL( hf.hf_615_passed(), dgp.time >= HARDFORK_615_TIME );
+      BOOST_CHECK_EQUAL( hf.core_2591_passed(), HARDFORK_CORE_2591_PASSED( dgp.time ) );
+   };
+
+   check();
+   BOOST_CHECK( !db.get_hardfork_state().core_1270_passed() );
+   BOOST_CHECK( !db.get_hardfork_state().all_passed() );
+
+   generate_blocks( HARDFORK_CORE_2591_TIME );
+   check();
+   generate_blocks( db.get_dynamic_global_properties().next_maintenance_time );
+   check();
+   BOOST_CHECK( db.get_hardfork_state().all_passed() );
+
+   // the state follows the dynamic global properties when blocks are popped
+   generate_block();
+   db.pop_block();
+   check();
+   BOOST_CHECK( db.get_hardfork_state().all_passed() );
+
+} FC_LOG_AND_RETHROW() }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,7 @@
 
 #include <graphene/chain/asset_object.hpp>
 #include <graphene/app/api.hpp>
+#include <graphene/grouped_orders/grouped_orders_plugin.hpp>
 
 #include "../common/database_fixture.hpp"
 
@@ -58,4 +59,87 @@ BOOST_AUTO_TEST_CASE(api_limit_get_grouped_limit_orders) {
     throw;
    }
 }
+
+BOOST_AUTO_TEST_CASE(grouped_limit_order_depth) {
+   try
+   {
+   ACTORS((alice)(bob));
+   const asset_object& usd = create_user_issued_asset( "USDUIA" );
+   const asset_id_type usd_id = usd.get_id();
+   fund( alice, asset(100000) );
+   issue_uia( bob, usd.amount(100000) );
+
+   graphene::app::orders_api orders_api(app);
+   auto grouped_orders = app.get_plugin<graphene::grouped_orders::grouped_orders_plugin>( "grouped_orders" );
+   const auto core = std::string( asset_id_type() );
+   const auto quote = std::string( usd_id );
+   const uint16_t group = 100;
+   optional<price> start;
+
+   // compare the prefix sums with sums over all groups
+   auto check_depth = [&]() {
+      auto groups = orders_api.get_grouped_limit_orders( core, quote, group, start, 100 );
+      auto depth = orders_api.get_grouped_limit_order_depth( core, quote, group, start, 100 );
+      BOOST_REQUIRE_EQUAL( depth.size(), groups.size() );
+      share_type running = 0;
+      for( size_t i = 0; i < groups.size(); ++i )
+      {
+         running += groups[i].total_for_sale;
+         BOOST_CHECK( depth[i].min_price == groups[i].min_price );
+         BOOST_CHECK_EQUAL( depth[i].total_for_sale.value, groups[i].total_for_sale.value );
+         BOOST_CHECK_EQUAL( depth[i].cumulative_for_sale.value, running.value );
+         BOOST_CHECK_EQUAL( grouped_orders->cumulative_for_sale( group, groups[i].min_price ).value,
+                            running.value );
+      }
+      // a page starting in the middle continues the cumulative amounts
+      if( groups.size() > 1 )
+      {
+         optional<price> second = groups[1].max_price;
+         auto page = orders_api.get_grouped_limit_order_depth( core, quote, group, second, 1 );
+         BOOST_REQUIRE_EQUAL( page.size(), 1u );
+         BOOST_CHECK_EQUAL( page[0].cumulative_for_sale.value, depth[1].cumulative_for_sale.value );
+      }
+      return groups.size();
+   };
+
+   BOOST_CHECK_EQUAL( check_depth(), 0u );
+
+   create_sell_order( alice_id, asset(1000), usd.amount(1000) );
+   create_sell_order( alice_id, asset(500), usd.amount(502) ); // joins the group above
+   BOOST_CHECK_EQUAL( check_depth(), 1u );
+
+   create_sell_order( alice_id, asset(1000), usd.amount(1100) );
+   const limit_order_object* to_cancel = create_sell_order( alice_id, asset(2000), usd.amount(3000) );
+   create_sell_order( alice_id, asset(3000), usd.amount(6000) );
+   BOOST_CHECK_EQUAL( check_depth(), 4u );
+
+   // amounts change in existing groups
+   create_sell_order( alice_id, asset(700), usd.amount(770) );
+   BOOST_CHECK_EQUAL( check_depth(), 4u );
+
+   // partially fill the best group
+   create_sell_order( bob_id, usd.amount(300), asset(200) );
+   BOOST_CHECK_EQUAL( check_depth(), 4u );
+
+   // remove a group
+   cancel_limit_order( *to_cancel );
+   BOOST_CHECK_EQUAL( check_depth(), 3u );
+
+   // create a group at the price of the removed one and one at a new price, both before the next block
+   create_sell_order( alice_id, asset(2000), usd.amount(3000) );
+   create_sell_order( alice_id, asset(4000), usd.amount(12000) );
+   BOOST_CHECK_EQUAL( check_depth(), 5u );
+
+   // the prefix sums are compacted when the block is applied
+   generate_block();
+   BOOST_CHECK_EQUAL( check_depth(), 5u );
+
+   create_sell_order( alice_id, asset(100), usd.amount(1000) );
+   BOOST_CHECK_EQUAL( check_depth(), 6u );
+   }catch (fc::exception &e)
+   {
+    edump((e.to_detail_string()));
+    throw;
+   }
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -25,6 +25,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <graphene/app/api.hpp>
+#include <graphene/app/broadcast_confirmation_registry.hpp>
 #include <graphene/chain/hardfork.hpp>
 
 #include <fc/crypto/digest.hpp>
@@ -130,4 +131,84 @@ BOOST_AUTO_TEST_CASE( broadcast_transaction_too_large ) {
    } FC_LOG_AND_RETHROW()
 }
 
+BOOST_AUTO_TEST_CASE( broadcast_confirmation_registry_test ) {
+   try {
+
+      ACTORS((alice)(bob));
+      fund( alice, asset( 1000000 ) );
+
+      auto& registry = app.get_broadcast_confirmations();
+      BOOST_CHECK_EQUAL( registry.size(), 0u );
+
+      uint32_t alice_called = 0;
+      uint32_t bob_called = 0;
+      auto alice_callback = [&]( const variant& v ) { ++alice_called; };
+      auto bob_callback = [&]( const variant& v ) { ++bob_called; };
+
+      auto make_transfer = [&]( const account_id_type& from, const fc::ecc::private_key& key, int64_t amount ) {
+         signed_transaction tx;
+         transfer_operation trans;
+         trans.from = from;
+         trans.to   = account_id_type();
+         trans.amount = asset( amount );
+         tx.operations.push_back( trans );
+         set_expiration( db, tx );
+         sign( tx, key );
+         return tx;
+      };
+
+      auto alice_api = std::make_shared< graphene::app::network_broadcast_api >( app );
+      auto bob_api = std::make_shared< graphene::app::network_broadcast_api >( app );
+
+      BOOST_TEST_MESSAGE( "Only the sessions waiting for the included transactions are called" );
+      alice_api->broadcast_transaction_with_callback( alice_callback, make_transfer( alice_id, alice_private_key, 1 ) );
+      alice_api->broadcast_transaction_with_callback( alice_callback, make_transfer( alice_id, alice_private_key, 2 ) );
+      BOOST_CHECK_EQUAL( registry.size(), 2u );
+
+      generate_block();
+      fc::usleep(fc::milliseconds(200)); // sleep a while to execute callbacks in another thread
+
+      BOOST_CHECK_EQUAL( alice_called, 2u );
+      BOOST_CHECK_EQUAL( bob_called, 0u );
+      BOOST_CHECK_EQUAL( registry.size(), 0u );
+
+      BOOST_TEST_MESSAGE( "Callbacks of a closed session are dropped" );
+      bob_api->broadcast_transaction_with_callback( bob_callback, make_transfer( alice_id, alice_private_key, 3 ) );
+      BOOST_CHECK_EQUAL( registry.size(), 1u );
+      bob_api.reset();
+      BOOST_CHECK_EQUAL( registry.size(), 0u );
+      generate_block();
+      fc::usleep(fc::milliseconds(200));
+      BOOST_CHECK_EQUAL( bob_called, 0u );
+
+      BOOST_TEST_MESSAGE( "Callbacks of transactions expiring at the head block time are kept" );
+      const uint64_t session = registry.new_session();
+      uint32_t expired_called = 0;
+      registry.add( session, transaction_id_type( fc::ripemd160::hash( string( "never included" ) ) ),
+                    db.head_block_time() + db.get_global_properties().parameters.block_interval,
+                    [&]( const signed_block&, uint32_t, const vector<operation_result>& ) { ++expired_called; } );
+      BOOST_CHECK_EQUAL( registry.size(), 1u );
+      generate_block();
+      BOOST_CHECK_EQUAL( registry.size(), 1u );
+
+      BOOST_TEST_MESSAGE( "A transaction expiring at the head block time can still be confirmed" );
+      signed_transaction at_head = make_transfer( alice_id, alice_private_key, 4 );
+      at_head.set_expiration( db.head_block_time() + db.get_global_properties().parameters.block_interval );
+      at_head.clear_signatures();
+      sign( at_head, alice_private_key );
+      uint32_t at_head_called = 0;
+      registry.add( session, at_head.id(), at_head.expiration,
+                    [&]( const signed_block&, uint32_t, const vector<operation_result>& ) { ++at_head_called; } );
+      BOOST_CHECK_EQUAL( registry.size(), 2u );
+      PUSH_TX( db, at_head );
+      generate_block();
+      BOOST_CHECK_EQUAL( at_head_called, 1u );
+
+      BOOST_TEST_MESSAGE( "Callbacks of expired transactions are dropped" );
+      BOOST_CHECK_EQUAL( registry.size(), 0u );
+      BOOST_CHECK_EQUAL( expired_called, 0u );
+
+   } FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_SUITE_END()
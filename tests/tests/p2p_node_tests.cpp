@@ -21,6 +21,7 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
+#include <atomic>
 #include <memory>
 #include <thread>
 #include <iostream>
@@ -34,10 +35,15 @@
 
 #include <graphene/net/node.hpp>
 #include <graphene/net/peer_connection.hpp>
+#include <graphene/net/known_items_filter.hpp>
+#include <graphene/net/ring_buffer.hpp>
+#include <graphene/net/sync_block_buffer.hpp>
 #include <graphene/utilities/tempdir.hpp>
 
 #include <fc/io/raw.hpp>
 
+#include <boost/endian/conversion.hpp>
+
 #include <fc/log/appender.hpp>
 #include <fc/log/console_appender.hpp>
 #include <fc/log/logger.hpp>
@@ -1002,4 +1008,268 @@ BOOST_AUTO_TEST_CASE( advertising_all_test )
    test_closing_connection_message( msg2 );
 }
 
+/****
+ * Testing the lock-free queue used to hand items over between threads
+ */
+BOOST_AUTO_TEST_CASE( ring_buffer_test )
+{
+   graphene::net::ring_buffer<uint64_t> queue( 1000 );
+   BOOST_CHECK_EQUAL( queue.capacity(), 1024U );
+
+   uint64_t item = 0;
+   BOOST_CHECK( !queue.try_pop( item ) );
+   for( uint64_t i = 0; i < queue.capacity(); ++i )
+      BOOST_CHECK( queue.try_push( uint64_t(i) ) );
+   BOOST_CHECK( !queue.try_push( uint64_t(0) ) );
+   for( uint64_t i = 0; i < queue.capacity(); ++i )
+   {
+      BOOST_REQUIRE( queue.try_pop( item ) );
+      BOOST_CHECK_EQUAL( item, i );
+   }
+   BOOST_CHECK( !queue.try_pop( item ) );
+
+   // several producers and one consumer
+   const uint64_t producers = 4;
+   const uint64_t items_per_producer = 100000;
+   std::vector<std::thread> threads;
+   for( uint64_t p = 0; p < producers; ++p )
+      threads.emplace_back( [&queue,p,items_per_producer]() {
+         for( uint64_t i = 1; i <= items_per_producer; ++i )
+            while( !queue.try_push( p * items_per_producer + i ) )
+               std::this_thread::yield();
+      });
+   uint64_t received = 0;
+   uint64_t sum = 0;
+   while( received < producers * items_per_producer )
+   {
+      if( queue.try_pop( item ) )
+      {
+         ++received;
+         sum += item;
+      }
+      else
+         std::this_thread::yield();
+   }
+   for( auto& t : threads )
+      t.join();
+   const uint64_t total = producers * items_per_producer;
+   BOOST_CHECK_EQUAL( sum, total * ( total + 1 ) / 2 );
+   BOOST_CHECK( !queue.try_pop( item ) );
+}
+
+class counting_node_delegate : public test_node_delegate
+{
+public:
+   std::atomic<uint32_t> transactions_handled { 0 };
+   std::atomic<uint32_t> has_item_calls { 0 };
+   std::shared_ptr<graphene::net::known_items_filter> known_items
+         = std::make_shared<graphene::net::known_items_filter>();
+
+   counting_node_delegate() : test_node_delegate( "counting" ) {}
+
+   std::shared_ptr<const graphene::net::known_items_filter> get_known_items_filter() const override
+   {
+      return known_items;
+   }
+
+   bool has_item( const graphene::net::item_id& id ) override
+   {
+      ++has_item_calls;
+      return false;
+   }
+   void handle_transaction( const graphene::net::trx_message& trx_msg ) override
+   {
+      ++transactions_handled;
+      FC_ASSERT( trx_msg.trx.ref_block_num != 0, "rejected" );
+   }
+};
+
+/****
+ * Testing that transactions are handed over to the delegate thread in batches,
+ * and that known items are answered without calling the delegate
+ */
+BOOST_AUTO_TEST_CASE( delegate_transaction_handoff_test )
+{
+   auto delegate = std::make_shared<counting_node_delegate>();
+   fc::thread delegate_thread( "delegate" );
+   fc::thread caller_thread( "caller" );
+   graphene::net::detail::statistics_gathering_node_delegate_wrapper wrapper( delegate, &delegate_thread );
+
+   const uint32_t num_transactions = 100;
+   std::atomic<uint32_t> rejected { 0 };
+   caller_thread.async( [&]() {
+      std::vector<fc::future<void>> callers;
+      for( uint32_t i = 0; i < num_transactions; ++i )
+         callers.push_back( fc::async( [&wrapper,&rejected,i]() {
+            graphene::net::trx_message msg;
+            msg.trx.ref_block_num = i % 10;
+            try
+            {
+               wrapper.handle_transaction( msg );
+            }
+            catch( const fc::assert_exception& )
+            {
+               ++rejected;
+            }
+         }) );
+      for( auto& f : callers )
+         f.wait();
+   }).wait();
+   BOOST_CHECK_EQUAL( delegate->transactions_handled.load(), num_transactions );
+   BOOST_CHECK_EQUAL( rejected.load(), num_transactions / 10 );
+
+   const graphene::net::item_id known( graphene::net::block_message_type, fc::ripemd160::hash( std::string("known") ) );
+   const graphene::net::item_id unknown( graphene::net::block_message_type, fc::ripemd160::hash( std::string("x") ) );
+   delegate->known_items->add( known );
+   caller_thread.async( [&]() {
+      BOOST_CHECK( wrapper.has_item( known ) );
+      BOOST_CHECK( !wrapper.has_item( unknown ) );
+   }).wait();
+   BOOST_CHECK_EQUAL( delegate->has_item_calls.load(), 1U );
+}
+
+/****
+ * Testing the filter of known items which answers has_item on the p2p thread
+ */
+BOOST_AUTO_TEST_CASE( known_items_filter_test )
+{
+   using graphene::net::known_items_filter;
+   using graphene::net::item_id;
+   using lookup_result = known_items_filter::lookup_result;
+
+   auto block_item = []( uint32_t block_num, const std::string& seed ) {
+      fc::ripemd160 id = fc::ripemd160::hash( seed );
+      id._hash[0] = boost::endian::endian_reverse( block_num );
+      BOOST_CHECK_EQUAL( graphene::protocol::block_header::num_from_id( id ), block_num );
+      return item_id( graphene::net::block_message_type, id );
+   };
+   auto trx_item = []( const std::string& seed ) {
+      return item_id( graphene::net::trx_message_type, fc::ripemd160::hash( seed ) );
+   };
+
+   known_items_filter filter;
+   // nothing is covered before the head block is known
+   BOOST_CHECK( filter.lookup( block_item( 5, "a" ) ) == lookup_result::maybe );
+
+   filter.set_head_block_num( 100 );
+   // blocks up to the head block at startup were never added
+   BOOST_CHECK( filter.lookup( block_item( 100, "a" ) ) == lookup_result::maybe );
+   // blocks after the head block are not known
+   BOOST_CHECK( filter.lookup( block_item( 101, "a" ) ) == lookup_result::unknown );
+   BOOST_CHECK( filter.lookup( trx_item( "a" ) ) == lookup_result::unknown );
+
+   for( uint32_t num = 101; num <= 200; ++num )
+   {
+      filter.add( block_item( num, "block" ) );
+      filter.set_head_block_num( num );
+   }
+   filter.add( trx_item( "trx" ) );
+   BOOST_CHECK( filter.lookup( block_item( 150, "block" ) ) == lookup_result::known );
+   BOOST_CHECK( filter.lookup( trx_item( "trx" ) ) == lookup_result::known );
+   // a block on another fork
+   BOOST_CHECK( filter.lookup( block_item( 150, "fork" ) ) == lookup_result::unknown );
+   BOOST_CHECK( filter.lookup( block_item( 201, "block" ) ) == lookup_result::unknown );
+
+   // Items which dropped out of the exact set are still in the Bloom filter
+   for( uint32_t i = 0; i < 30000; ++i )
+      filter.add( trx_item( "filler" + std::to_string( i ) ) );
+   BOOST_CHECK( filter.lookup( block_item( 150, "block" ) ) == lookup_result::maybe );
+   BOOST_CHECK( filter.lookup( trx_item( "trx" ) ) == lookup_result::maybe );
+   BOOST_CHECK( filter.lookup( trx_item( "filler29999" ) ) == lookup_result::known );
+
+   // After the Bloom filter rotated twice, old items are forgotten but old blocks are not reported as unknown
+   for( uint32_t i = 0; i < 250000; ++i )
+      filter.add( trx_item( "more" + std::to_string( i ) ) );
+   BOOST_CHECK( filter.lookup( block_item( 150, "fork" ) ) == lookup_result::maybe );
+   BOOST_CHECK( filter.lookup( block_item( 201, "block" ) ) == lookup_result::unknown );
+}
+
+BOOST_AUTO_TEST_CASE( sync_block_buffer_test )
+{
+   using graphene::net::block_message;
+
+   std::vector<block_message> blocks;
+   graphene::protocol::signed_block prev;
+   for( uint32_t i = 0; i < 10; ++i )
+   {
+      graphene::protocol::signed_block b;
+      b.previous = prev.id();
+      blocks.emplace_back( b );
+      prev = b;
+   }
+   const uint64_t block_size = fc::raw::pack_size( blocks.front().block );
+
+   graphene::net::sync_block_buffer buffer( 5 * block_size );
+   // received out of order
+   for( size_t i : { 3, 1, 0, 2 } )
+      BOOST_CHECK( buffer.add( blocks[i] ) );
+   BOOST_CHECK( !buffer.add( blocks[1] ) );
+   BOOST_CHECK_EQUAL( buffer.size(), 4u );
+   BOOST_CHECK_EQUAL( buffer.packed_size(), 4 * block_size );
+   BOOST_CHECK( buffer.contains( blocks[2].block_id ) );
+   BOOST_CHECK( !buffer.contains( blocks[4].block_id ) );
+
+   auto taken = buffer.take( blocks[0].block_id );
+   BOOST_REQUIRE( taken.valid() );
+   BOOST_CHECK( taken->block_id == blocks[0].block_id );
+   BOOST_CHECK( taken->block.previous == blocks[0].block.previous );
+   BOOST_CHECK( !buffer.take( blocks[0].block_id ).valid() );
+   BOOST_CHECK_EQUAL( buffer.size(), 3u );
+
+   // the blocks with the highest numbers are dropped when the buffer is full
+   for( size_t i = 4; i < 7; ++i )
+      buffer.add( blocks[i] );
+   BOOST_CHECK( buffer.full() );
+   BOOST_CHECK_EQUAL( buffer.size(), 5u );
+   BOOST_CHECK_EQUAL( buffer.dropped_blocks(), 1u );
+   BOOST_CHECK( !buffer.contains( blocks[6].block_id ) );
+   BOOST_CHECK( !buffer.add( blocks[7] ) );
+   BOOST_CHECK( buffer.add( blocks[0] ) );
+   BOOST_CHECK( !buffer.contains( blocks[5].block_id ) );
+
+   buffer.remove( blocks[1].block_id );
+   BOOST_CHECK( !buffer.contains( blocks[1].block_id ) );
+   BOOST_CHECK_EQUAL( buffer.packed_size(), 4 * block_size );
+   buffer.clear();
+   BOOST_CHECK( buffer.empty() );
+   BOOST_CHECK_EQUAL( buffer.packed_size(), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( sync_throughput_meter_test )
+{
+   graphene::net::sync_throughput_meter fast;
+   const fc::time_point start = fc::time_point::now();
+   BOOST_CHECK_EQUAL( fast.window( 10, 200 ), 200u );
+
+   fast.requests_sent( start );
+   fast.block_received( start + fc::milliseconds( 500 ) );
+   BOOST_CHECK_EQUAL( fast.latency.count(), fc::milliseconds( 500 ).count() );
+   for( int i = 1; i < 20; ++i )
+   {
+      fast.block_received( start + fc::milliseconds( 500 + 10 * i ) );
+      // not measured yet, the largest window is used
+      if( i < 9 )
+         BOOST_CHECK_EQUAL( fast.window( 10, 200 ), 200u );
+   }
+   BOOST_CHECK( fast.is_measured() );
+   BOOST_CHECK_CLOSE( fast.blocks_per_second, 100.0, 0.001 );
+   // blocks delivered within the latency plus one second
+   BOOST_CHECK_EQUAL( fast.window( 10, 200 ), 150u );
+   BOOST_CHECK_EQUAL( fast.window( 10, 50 ), 50u );
+
+   // the latency is only measured on the first block after the peer had nothing in flight
+   fast.requests_sent( start + fc::seconds( 10 ) );
+   fast.block_received( start + fc::seconds( 11 ) );
+   BOOST_CHECK_EQUAL( fast.latency.count(), fc::milliseconds( 600 ).count() );
+   BOOST_CHECK_CLOSE( fast.blocks_per_second, 100.0, 0.001 );
+
+   graphene::net::sync_throughput_meter slow;
+   slow.requests_sent( start );
+   for( int i = 0; i < 20; ++i )
+      slow.block_received( start + fc::seconds( 1 + i ) );
+   BOOST_CHECK_CLOSE( slow.blocks_per_second, 1.0, 0.001 );
+   BOOST_CHECK_EQUAL( slow.window( 10, 200 ), 10u );
+   BOOST_CHECK_EQUAL( slow.window( 1, 200 ), 2u );
+}
+
 BOOST_AUTO_TEST_SUITE_END()